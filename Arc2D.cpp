@@ -1,61 +1,107 @@
 #include "Arc2D.hpp"
 
-#include <boost/geometry/algorithms/intersects.hpp>
+#include "SinCos.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /**
+     * Returns the point at the given distance and heading from (x, y).
+     */
+    Arc2D::Point pointAt( double x, double y, double radius, double angle )
+    {
+        SinCos heading( angle );
+        return Arc2D::Point( radius * heading.sin() + x, radius * heading.cos() + y );
+    }
+}
 
 Arc2D::Arc2D( double x, double y, double radius, double startAngle, double extent )
 : m_origin( x, y ),
-m_start( x, y + radius ),
-m_end( x, y + radius )
+m_start( pointAt( x, y, radius, startAngle ) ),
+m_end( pointAt( x, y, radius, startAngle + extent ) )
 {
-    namespace bg = boost::geometry;
-    namespace trans = boost::geometry::strategy::transform;
-
-    trans::rotate_transformer<boost::geometry::radian, double, 2, 2> rotate( startAngle );
-    trans::rotate_transformer<boost::geometry::radian, double, 2, 2> extend( startAngle + extent );
-    trans::translate_transformer<double, 2, 2> translate( x, y );
-
-    Point radius_point( 0, radius );
-
-    boost::geometry::transform( radius_point, m_start, rotate );
-    boost::geometry::transform( m_start, m_start, translate );
-    boost::geometry::transform( radius_point, m_end, extend );
-    boost::geometry::transform( m_end, m_end, translate );
-
-    bg::append( m_polygon, m_origin );
-    bg::append( m_polygon, m_start );
-    bg::append( m_polygon, m_end );
-    bg::append( m_polygon, m_origin );
-
-    bg::correct( m_polygon );
+    const Point corners[3] = { m_origin, m_start, m_end };
+
+    m_minX = std::min( { m_origin.x(), m_start.x(), m_end.x() } );
+    m_minY = std::min( { m_origin.y(), m_start.y(), m_end.y() } );
+    m_maxX = std::max( { m_origin.x(), m_start.x(), m_end.x() } );
+    m_maxY = std::max( { m_origin.y(), m_start.y(), m_end.y() } );
+
+    for( int i = 0; i < 3; ++i )
+    {
+        const Point& a = corners[i];
+        const Point& b = corners[( i + 1 ) % 3];
+        const Point& c = corners[( i + 2 ) % 3];
+
+        // an edge of zero length has a null normal, on which everything overlaps
+        m_normalX[i] = a.y() - b.y();
+        m_normalY[i] = b.x() - a.x();
+
+        double edge = m_normalX[i] * a.x() + m_normalY[i] * a.y();
+        double opposite = m_normalX[i] * c.x() + m_normalY[i] * c.y();
+        m_min[i] = std::min( edge, opposite );
+        m_max[i] = std::max( edge, opposite );
+    }
 }
 
-bool Arc2D::within( double x, double y )
+bool Arc2D::within( double x, double y ) const
 {
-    Point point(x, y);
-    return boost::geometry::within( point, m_polygon );
+    for( int i = 0; i < 3; ++i )
+    {
+        double projection = m_normalX[i] * x + m_normalY[i] * y;
+        if( !( projection > m_min[i] && projection < m_max[i] ) )
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
-bool Arc2D::intersects( Polygon poly ) const
+bool Arc2D::intersects( const sf::FloatRect& rect ) const
 {
-    bool res = boost::geometry::intersects( m_polygon, poly );
-    return res;
+    // the far corners are computed in float, like the rectangle itself
+    double left = rect.left;
+    double top = rect.top;
+    double right = rect.left + rect.width;
+    double bottom = rect.top + rect.height;
+
+    // the axes of the box
+    if( right < m_minX || left > m_maxX || bottom < m_minY || top > m_maxY )
+    {
+        return false;
+    }
+
+    // the normals of the triangle
+    for( int i = 0; i < 3; ++i )
+    {
+        double nx = m_normalX[i];
+        double ny = m_normalY[i];
+        double low = nx * ( nx >= 0 ? left : right ) + ny * ( ny >= 0 ? top : bottom );
+        double high = nx * ( nx >= 0 ? right : left ) + ny * ( ny >= 0 ? bottom : top );
+        if( high < m_min[i] || low > m_max[i] )
+        {
+            return false;
+        }
+    }
+
+    return true;
 }
 
-bool Arc2D::intersects( sf::FloatRect rect ) const
+void Arc2D::intersects( Span<const sf::FloatRect> rects, Span<std::uint8_t> hits ) const
 {
-    namespace bg = boost::geometry;
-
-    Polygon poly;
-
-    bg::append( poly, Point( rect.left, rect.top ) );
-    bg::append( poly, Point( rect.left + rect.width, rect.top ) );
-    bg::append( poly, Point( rect.left + rect.width, rect.top + rect.height ) );
-    bg::append( poly, Point( rect.left, rect.top + rect.height ) );
-    bg::append( poly, Point( rect.left, rect.top ) );
-
-    bg::correct( poly );
+    for( std::size_t i = 0; i < rects.size(); ++i )
+    {
+        hits[i] = intersects( rects[i] );
+    }
+}
 
-    return intersects( poly );
+bool Arc2D::operator==( const Arc2D& other ) const
+{
+    return m_origin.x() == other.m_origin.x() && m_origin.y() == other.m_origin.y()
+        && m_start.x() == other.m_start.x() && m_start.y() == other.m_start.y()
+        && m_end.x() == other.m_end.x() && m_end.y() == other.m_end.y();
 }
 
 Arc2D::Point Arc2D::origin() const
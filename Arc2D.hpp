@@ -1,23 +1,68 @@
 #pragma once
 
+#include "Span.hpp"
 
 #include <SFML/Graphics/Rect.hpp>
 
-#include <boost/geometry.hpp>
-#include <boost/geometry/geometries/point_xy.hpp>
+#include <cstdint>
 
+/**
+ * Area swept by a radar during a turn: the triangle between the robot and
+ * the ends of the radar beam at the start and at the end of the turn.
+ *
+ * Intersections with boxes are tested on the separating axes of the
+ * triangle and the box, whose projections of the triangle are computed
+ * once, when the arc is built: testing a box allocates nothing and costs a
+ * handful of multiplications.
+ */
 class Arc2D
 {
 public:
-    typedef boost::geometry::model::d2::point_xy<double> Point;
-    typedef boost::geometry::model::polygon<Point>       Polygon;
+    class Point
+    {
+    public:
+        Point( double x = 0, double y = 0 )
+        : m_x( x ),
+        m_y( y )
+        {
+        }
 
+        double x() const { return m_x; }
+        double y() const { return m_y; }
+
+    private:
+        double m_x;
+        double m_y;
+    };
+
+    /**
+     * @param x the position of the robot
+     * @param y the position of the robot
+     * @param radius the length of the radar beam
+     * @param startAngle the heading of the beam at the start of the turn, in radians
+     * @param extent the angle the beam turned by, in radians, clockwise
+     */
     Arc2D( double x, double y, double radius, double startAngle, double extent );
 
-    bool within( double x, double y );
+    /**
+     * Returns whether a point is strictly inside the arc.
+     */
+    bool within( double x, double y ) const;
+
+    /**
+     * Returns whether a box touches the arc, its border included.
+     */
+    bool intersects( const sf::FloatRect& rect ) const;
 
-    bool intersects( Polygon poly ) const;
-    bool intersects( sf::FloatRect rect ) const;
+    /**
+     * Tests a batch of boxes: hits[i] tells whether rects[i] touches the arc.
+     */
+    void intersects( Span<const sf::FloatRect> rects, Span<std::uint8_t> hits ) const;
+
+    /**
+     * Returns whether two arcs cover exactly the same area.
+     */
+    bool operator==( const Arc2D& other ) const;
 
     Point origin() const;
     Point start() const;
@@ -27,5 +72,16 @@ private:
     Point m_origin;
     Point m_start;
     Point m_end;
-    Polygon m_polygon;
-};
\ No newline at end of file
+
+    // bounding box of the triangle
+    double m_minX;
+    double m_minY;
+    double m_maxX;
+    double m_maxY;
+
+    // normal of each edge, and the projection of the triangle on it
+    double m_normalX[3];
+    double m_normalY[3];
+    double m_min[3];
+    double m_max[3];
+};
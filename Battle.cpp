@@ -5,13 +5,14 @@
 #include "BattleEndedEvent.hpp"
 #include "RoundEndedEvent.hpp"
 
+#include <algorithm>
 #include <iostream>
-#include <random>
 
-Battle::Battle( World& world, std::size_t numRounds )
+Battle::Battle( World& world, std::size_t numRounds, std::uint64_t seed )
 : m_world( world ),
 m_numRounds( numRounds ),
-m_round( 0 )
+m_round( 0 ),
+m_seed( seed )
 {
 }
 
@@ -20,6 +21,12 @@ void Battle::addRobot( Robot* pRobot )
     m_robots.push_back( pRobot );
 }
 
+void Battle::skipToRound( std::size_t round )
+{
+    m_world.reset();
+    m_round = round - 1;
+}
+
 void Battle::tick()
 {
     if( ended() )
@@ -54,12 +61,22 @@ bool Battle::ended()
 
 void Battle::handleDeadRobots()
 {
-    for( auto&& pRobot : m_robots )
+    ScoreLedger& scores = m_world.getContext().getScoreLedger();
+
+    // only the robots still in the world can have died during this turn, and
+    // the robots dying during the same turn share their placement
+    for( auto&& pRobot : m_world.getRobots() )
     {
         if( pRobot->isDead() )
         {
-            pRobot->getRobotStatistics().scoreRobotDeath( std::count_if(m_robots.begin(), m_robots.end(),
-                [](const Robot* r) { return r->isAlive(); } ) );
+            scores.removeSurvivor();
+        }
+    }
+    for( auto&& pRobot : m_world.getRobots() )
+    {
+        if( pRobot->isDead() )
+        {
+            pRobot->getRobotStatistics().scoreRobotDeath( scores.getSurvivorCount() );
         }
     }
 
@@ -68,6 +85,18 @@ void Battle::handleDeadRobots()
 
 void Battle::setupRound()
 {
+    // every round draws from its own stream of the battle seed, so that it
+    // only depends on (seed, round) and can be replayed in isolation
+    m_world.getContext().seed( m_seed, m_round );
+
+    RandomStream& random = m_world.getContext().getRandom();
+
+    // the damage dealt to each robot decides the kill bonuses of this round only
+    m_world.getContext().getScoreLedger().beginRound( m_robots.size() );
+
+    SweepAndPrune& placed = m_world.getRobotPairs();
+    placed.clear();
+
     for( auto&& pRobot : m_robots )
     {
         std::size_t retry_count = 0;
@@ -76,18 +105,18 @@ void Battle::setupRound()
             ++retry_count;
 
             // pick a random position
-            std::uniform_int_distribution<> xDist( ( Robot::WIDTH * 2 ), m_world.getWidth() - ( Robot::WIDTH * 2 ) );
-            std::uniform_int_distribution<> yDist( ( Robot::HEIGHT * 2 ), m_world.getHeight() - ( Robot::HEIGHT * 2 ) );
-            //std::uniform_int_distribution<> xDist( 0, 200 );
-            //std::uniform_int_distribution<> yDist( 0, 200 );
-            int x = xDist(Utils::getRandom());
-            int y = yDist(Utils::getRandom());
+            int x = random.nextInt( Robot::WIDTH * 2, m_world.getWidth() - ( Robot::WIDTH * 2 ) );
+            int y = random.nextInt( Robot::HEIGHT * 2, m_world.getHeight() - ( Robot::HEIGHT * 2 ) );
 
             // move robot there
             pRobot->setPosition( x, y );
-        } while( pRobot->isCollidingRobot( m_world.getRobots() ) && retry_count < 100 );
+        } while( placed.overlaps( pRobot->getBoundingBox() ) && retry_count < 100 );
 
-        // add it to the world
+        // add it to the world; a robot killed in the previous round is not reset yet, and is not in the way
+        if( !pRobot->isDead() )
+        {
+            placed.insert( m_world.getRobots().size(), pRobot->getBoundingBox() );
+        }
         m_world.addRobot( pRobot );
     }
 
@@ -101,24 +130,46 @@ void Battle::endRound()
 {
     for( auto&& pRobot : m_robots )
     {
-        pRobot->addEvent( std::make_unique<RoundEndedEvent>() );
+        pRobot->addEvent<RoundEndedEvent>();
         if (pRobot->isAlive() && !pRobot->isWinner())
         {
             pRobot->getRobotStatistics().scoreLastSurvivor();
             pRobot->setWinner(true);
             std::cout << "SYSTEM: " << pRobot->getNameForEvent( pRobot ) << " wins the round." << std::endl;
-            //pRobot->addEvent( std::make_unique<WinEvent>() );
+            //pRobot->addEvent<WinEvent>();
         }
         pRobot->getRobotStatistics().generateTotals();
+
+        // deliver now rather than at the beginning of the next round, which
+        // must not depend on what happened in this one
+        pRobot->processEvents();
     }
 
     m_world.reset();
 }
 
+std::vector<BattleResults> Battle::getResults()
+{
+    std::vector<Robot*> ranking( m_robots.begin(), m_robots.end() );
+
+    std::stable_sort( ranking.begin(), ranking.end(),
+        []( Robot* a, Robot* b ) { return a->getRobotStatistics().getTotalScore() > b->getRobotStatistics().getTotalScore(); } );
+
+    std::vector<BattleResults> results;
+    for( std::size_t i = 0; i < ranking.size(); ++i )
+    {
+        ranking[i]->getRobotStatistics().setRank( i + 1 );
+        results.push_back( ranking[i]->getRobotStatistics().getFinalResults() );
+    }
+
+    return results;
+}
+
 void Battle::endBattle()
 {
     for( auto&& pRobot : m_robots )
     {
-        pRobot->addEvent( std::make_unique<BattleEndedEvent>( ) );
+        pRobot->addEvent<BattleEndedEvent>();
+        pRobot->processEvents();
     }
 }
\ No newline at end of file
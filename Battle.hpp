@@ -1,19 +1,35 @@
 #pragma once
 
 #include "Robot.hpp"
+#include "BattleResults.hpp"
+
+#include <cstdint>
+#include <list>
+#include <vector>
 
 class World;
 
 class Battle
 {
 public:
-    Battle( World& world, std::size_t numRounds );
+    Battle( World& world, std::size_t numRounds, std::uint64_t seed );
 
     void addRobot( Robot* pRobot );
     void tick();
+    bool ended();
+
+    /**
+     * Makes the next tick start the given round (1-based), e.g. to replay
+     * a single round of a seeded battle in isolation.
+     */
+    void skipToRound( std::size_t round );
+
+    std::size_t getRound() const { return m_round; }
+    std::uint64_t getSeed() const { return m_seed; }
+
+    std::vector<BattleResults> getResults();
 
 protected:
-    bool ended();
     void handleDeadRobots();
     void setupRound();
     void endRound();
@@ -24,4 +40,5 @@ private:
     std::list<Robot*> m_robots;
     std::size_t m_numRounds;
     std::size_t m_round;
+    std::uint64_t m_seed;
 };
\ No newline at end of file
@@ -5,6 +5,8 @@
 class BattleEndedEvent : public Event
 {
 public:
+	static constexpr int DEFAULT_PRIORITY = 100;
+
 	BattleEndedEvent()
 	{
 	}
@@ -0,0 +1,165 @@
+#include "BattleFarm.hpp"
+
+#include "World.hpp"
+#include "Battle.hpp"
+
+#include <algorithm>
+#include <map>
+
+BattleFarm::BattleFarm( std::size_t numThreads )
+: m_pending( 0 ),
+m_stopping( false ),
+m_ticks( 0 )
+{
+    numThreads = std::max<std::size_t>( numThreads, 1 );
+
+    for( std::size_t i = 0; i < numThreads; ++i )
+    {
+        m_workers.emplace_back( &BattleFarm::workerLoop, this );
+    }
+}
+
+BattleFarm::~BattleFarm()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+
+    for( auto&& worker : m_workers )
+    {
+        worker.join();
+    }
+}
+
+std::size_t BattleFarm::submit( BattleSetup setup )
+{
+    std::size_t index;
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        index = m_setups.size();
+        m_setups.push_back( std::move( setup ) );
+        m_results.emplace_back();
+        m_queue.push_back( index );
+        ++m_pending;
+    }
+    m_workAvailable.notify_one();
+
+    return index;
+}
+
+std::vector<std::vector<BattleResults>> BattleFarm::wait()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_workDone.wait( lock, [this] { return m_pending == 0; } );
+
+    m_setups.clear();
+    return std::move( m_results );
+}
+
+Profiler BattleFarm::getProfile()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    return m_profile;
+}
+
+std::vector<BattleResults> BattleFarm::aggregate( const std::vector<std::vector<BattleResults>>& battles )
+{
+    std::map<std::string, BattleResults> totals;
+
+    for( auto&& battle : battles )
+    {
+        for( auto&& results : battle )
+        {
+            auto it = totals.find( results.getTeamLeaderName() );
+            if( it == totals.end() )
+            {
+                totals.emplace( results.getTeamLeaderName(), results );
+            }
+            else
+            {
+                it->second += results;
+            }
+        }
+    }
+
+    std::vector<BattleResults> ranking;
+    for( auto&& entry : totals )
+    {
+        ranking.push_back( entry.second );
+    }
+
+    std::stable_sort( ranking.begin(), ranking.end(),
+        []( const BattleResults& a, const BattleResults& b ) { return b < a; } );
+
+    for( std::size_t i = 0; i < ranking.size(); ++i )
+    {
+        ranking[i].setRank( i + 1 );
+    }
+
+    return ranking;
+}
+
+void BattleFarm::workerLoop()
+{
+    for( ;; )
+    {
+        std::size_t index;
+        BattleSetup setup;
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_workAvailable.wait( lock, [this] { return m_stopping || !m_queue.empty(); } );
+
+            if( m_queue.empty() )
+            {
+                return;
+            }
+
+            index = m_queue.front();
+            m_queue.pop_front();
+            // copied: m_setups may grow while the battle is running
+            setup = m_setups[index];
+        }
+
+        std::vector<BattleResults> results = runBattle( setup );
+
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            m_results[index] = std::move( results );
+            --m_pending;
+        }
+        m_workDone.notify_all();
+    }
+}
+
+std::vector<BattleResults> BattleFarm::runBattle( const BattleSetup& setup )
+{
+    World world;
+    Battle battle( world, setup.numRounds, setup.seed );
+    world.getContext().getProfiler().setEnabled( setup.profile );
+
+    std::vector<std::unique_ptr<Robot>> robots;
+    for( auto&& factory : setup.robots )
+    {
+        robots.push_back( factory( world ) );
+        battle.addRobot( robots.back().get() );
+    }
+
+    std::size_t ticks = 0;
+    while( !battle.ended() )
+    {
+        battle.tick();
+        ++ticks;
+    }
+
+    m_ticks += ticks;
+
+    if( setup.profile )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_profile += world.getContext().getProfiler();
+    }
+
+    return battle.getResults();
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "BattleResults.hpp"
+#include "Profiler.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Robot;
+class World;
+
+/**
+ * Creates one robot in the given world. A factory is called once per battle,
+ * so that every battle gets its own robot instances.
+ */
+typedef std::function<std::unique_ptr<Robot>( World& world )> RobotFactory;
+
+/**
+ * Runs independent battles on a fixed pool of worker threads.
+ *
+ * Every battle gets its own World, robots and Battle, built by the worker
+ * that runs it; nothing is shared between battles, so the farm scales with
+ * the number of cores.
+ */
+class BattleFarm
+{
+public:
+    struct BattleSetup
+    {
+        std::vector<RobotFactory> robots;
+        std::size_t numRounds;
+        std::uint64_t seed;
+
+        /** Whether to time the phases of the ticks, see getProfile(). */
+        bool profile = false;
+    };
+
+    explicit BattleFarm( std::size_t numThreads = std::thread::hardware_concurrency() );
+    ~BattleFarm();
+
+    BattleFarm( const BattleFarm& ) = delete;
+    BattleFarm& operator=( const BattleFarm& ) = delete;
+
+    /**
+     * Queues a battle.
+     *
+     * @return the index of the battle in the vector returned by wait()
+     */
+    std::size_t submit( BattleSetup setup );
+
+    /**
+     * Blocks until every submitted battle has ended.
+     *
+     * @return the results of each battle, in submission order
+     */
+    std::vector<std::vector<BattleResults>> wait();
+
+    std::size_t getNumThreads() const { return m_workers.size(); }
+    std::size_t getTickCount() const { return m_ticks; }
+
+    /**
+     * Returns the sum of the profiles of the ended battles that were
+     * submitted with profiling on.
+     */
+    Profiler getProfile();
+
+    /**
+     * Sums the results of several battles per robot name and ranks the totals by score.
+     */
+    static std::vector<BattleResults> aggregate( const std::vector<std::vector<BattleResults>>& battles );
+
+private:
+    void workerLoop();
+    std::vector<BattleResults> runBattle( const BattleSetup& setup );
+
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_workDone;
+
+    std::deque<std::size_t> m_queue;
+    std::vector<BattleSetup> m_setups;
+    std::vector<std::vector<BattleResults>> m_results;
+    std::size_t m_pending;
+    bool m_stopping;
+
+    std::atomic<std::size_t> m_ticks;
+    Profiler m_profile;
+};
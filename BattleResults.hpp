@@ -1,5 +1,7 @@
 #pragma once
 
+#include <boost/property_tree/ptree.hpp>
+
 #include <string>
 
 /**
@@ -68,7 +70,7 @@ public:
 	 *
 	 * @return the name of the team leader in the team or the name of the robot.
 	 */
-	std::string getTeamLeaderName() {
+	std::string getTeamLeaderName() const {
 		return teamLeaderName;
 	}
 
@@ -171,10 +173,81 @@ public:
 		return thirds;
 	}
 
+	/**
+	 * Sets the rank of this robot in the battle results.
+	 *
+	 * @param newRank the rank of this robot in the battle results.
+	 */
+	void setRank( int newRank ) {
+		rank = newRank;
+	}
+
+	/**
+	 * Adds the scores of another result of the same robot, e.g. from another battle.
+	 *
+	 * @param other the results to add to these ones.
+	 * @return these results.
+	 */
+	BattleResults& operator+=( const BattleResults& other ) {
+		score += other.score;
+		survival += other.survival;
+		lastSurvivorBonus += other.lastSurvivorBonus;
+		bulletDamage += other.bulletDamage;
+		bulletDamageBonus += other.bulletDamageBonus;
+		ramDamage += other.ramDamage;
+		ramDamageBonus += other.ramDamageBonus;
+		firsts += other.firsts;
+		seconds += other.seconds;
+		thirds += other.thirds;
+		return *this;
+	}
+
+	/**
+	 * Writes these results, unrounded, into a property tree, e.g. to cache them in a file.
+	 *
+	 * @param tree the tree to write to.
+	 */
+	void save( boost::property_tree::ptree& tree ) const {
+		tree.put( "teamLeaderName", teamLeaderName );
+		tree.put( "rank", rank );
+		tree.put( "score", score );
+		tree.put( "survival", survival );
+		tree.put( "lastSurvivorBonus", lastSurvivorBonus );
+		tree.put( "bulletDamage", bulletDamage );
+		tree.put( "bulletDamageBonus", bulletDamageBonus );
+		tree.put( "ramDamage", ramDamage );
+		tree.put( "ramDamageBonus", ramDamageBonus );
+		tree.put( "firsts", firsts );
+		tree.put( "seconds", seconds );
+		tree.put( "thirds", thirds );
+	}
+
+	/**
+	 * Reads results written by save().
+	 *
+	 * @param tree the tree to read from.
+	 * @return the results.
+	 */
+	static BattleResults load( const boost::property_tree::ptree& tree ) {
+		return BattleResults(
+				tree.get<std::string>( "teamLeaderName" ),
+				tree.get<int>( "rank" ),
+				tree.get<double>( "score" ),
+				tree.get<double>( "survival" ),
+				tree.get<double>( "lastSurvivorBonus" ),
+				tree.get<double>( "bulletDamage" ),
+				tree.get<double>( "bulletDamageBonus" ),
+				tree.get<double>( "ramDamage" ),
+				tree.get<double>( "ramDamageBonus" ),
+				tree.get<int>( "firsts" ),
+				tree.get<int>( "seconds" ),
+				tree.get<int>( "thirds" ) );
+	}
+
 	/**
 	 * {@inheritDoc}
 	 */
-	bool operator<( const BattleResults& other ) {
+	bool operator<( const BattleResults& other ) const {
 		return score < other.score;
 	}
 private:
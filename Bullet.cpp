@@ -1,6 +1,8 @@
 #include "Bullet.hpp"
 
 #include "World.hpp"
+#include "BulletPool.hpp"
+#include "RobotGrid.hpp"
 #include "Robot.hpp"
 #include "BulletHitBulletEvent.hpp"
 //#include "HitByBulletEvent.hpp"
@@ -91,8 +93,6 @@ bool intersects( sf::FloatRect rect, Line2D line )
     return true;
 }
 
-std::size_t Bullet::s_globalBulletId = 0;
-
 int Bullet::getExplosionImageIndex() {
     return m_explosionImageIndex;
 }
@@ -106,8 +106,16 @@ int Bullet::getBulletId() {
     return m_bulletId;
 }
 
+BulletHandle Bullet::getHandle() const {
+    return m_handle;
+}
+
+void Bullet::setHandle(BulletHandle handle) {
+    m_handle = handle;
+}
+
 int Bullet::getFrame() {
-    return m_frame;
+    return frame();
 }
 
 double Bullet::getHeading() {
@@ -131,27 +139,28 @@ Robot* Bullet::getVictim() {
 }
 
 double Bullet::getX() {
-    return m_x;
+    return x();
 }
 
 double Bullet::getY() {
-    return m_y;
+    return y();
 }
 
 double Bullet::getPaintX() {
-    return (m_state == HIT_VICTIM && m_victim != nullptr) ? m_victim->getX() + m_deltaX : m_x;
+    return (state() == HIT_VICTIM && m_victim != nullptr) ? m_victim->getX() + m_deltaX : x();
 }
 
 double Bullet::getPaintY() {
-    return (m_state == HIT_VICTIM && m_victim != nullptr) ? m_victim->getY() + m_deltaY : m_y;
+    return (state() == HIT_VICTIM && m_victim != nullptr) ? m_victim->getY() + m_deltaY : y();
 }
 
 bool Bullet::isActive() const {
-    return m_state == FIRED || m_state == MOVING;
+    BulletState state = getState();
+    return state == FIRED || state == MOVING;
 }
 
 Bullet::BulletState Bullet::getState() const {
-    return m_state;
+    return m_pool->getState(m_handle.index);
 }
 
 sf::Color Bullet::getColor() const {
@@ -160,10 +169,12 @@ sf::Color Bullet::getColor() const {
 
 void Bullet::setHeading(double newHeading) {
     m_heading = newHeading;
+    m_pool->updateVelocity(m_handle.index);
 }
 
 void Bullet::setPower(double newPower) {
     m_power = newPower;
+    m_pool->updateVelocity(m_handle.index);
 }
 
 void Bullet::setm_victim(Robot* newVictim) {
@@ -171,59 +182,90 @@ void Bullet::setm_victim(Robot* newVictim) {
 }
 
 void Bullet::setX(double newX) {
-    m_x = m_lastX = newX;
+    m_pool->setX(m_handle.index, newX);
 }
 
 void Bullet::setY(double newY) {
-    m_y = m_lastY = newY;
+    m_pool->setY(m_handle.index, newY);
 }
 
 void Bullet::setState(BulletState newState) {
-    m_state = newState;
+    m_pool->setState(m_handle.index, newState);
 }
 
-void Bullet::update(std::list<Robot*> robots, std::list<Bullet> bullets) {
-    m_frame++;
+void Bullet::update(Span<Robot*> robots, RobotGrid& grid, BulletPool& bullets) {
+    // the frame, the movement, the wall collisions and the end of the explosions are done by BulletPool::move()
     if (isActive()) {
-        updateMovement();
-        checkWallCollision();
-        if (isActive()) {
-            checkRobotCollision(robots);
-        }
-        if (isActive()) {
-            checkBulletCollision(bullets);
-        }
+        checkRobotCollision(robots, grid);
+    }
+    if (isActive()) {
+        checkBulletCollision(bullets);
     }
-    updateBulletState();
     //m_owner->addBulletStatus(createStatus());
 }
 
-Bullet::Bullet(Robot* owner)
+Bullet::Bullet(Robot* owner, BulletPool& pool)
 : m_world( &owner->getWorld() ),
-m_bulletId( ++s_globalBulletId )
+m_pool( &pool ),
+m_bulletId( m_world->getContext().nextBulletId() ),
+m_victim( nullptr ),
+m_heading( 0 ),
+m_power( 0 ),
+m_deltaX( 0 ),
+m_deltaY( 0 ),
+m_explosionImageIndex( 0 )
 {
     m_owner = owner;
-    m_state = FIRED;
     m_color = m_owner->getBulletColor(); // Store current bullet color set on robot
 }
 
-void Bullet::checkBulletCollision(std::list<Bullet> bullets) {
-    for( auto&& b : bullets )
+double Bullet::x() {
+    return m_pool->getX(m_handle.index);
+}
+
+double Bullet::y() {
+    return m_pool->getY(m_handle.index);
+}
+
+double Bullet::lastX() {
+    return m_pool->getLastX(m_handle.index);
+}
+
+double Bullet::lastY() {
+    return m_pool->getLastY(m_handle.index);
+}
+
+Bullet::BulletState Bullet::state() {
+    return getState();
+}
+
+int Bullet::frame() {
+    return m_pool->getFrame(m_handle.index);
+}
+
+Line2D Bullet::getBoundingLine() {
+    Line2D line;
+    line.setLine(lastX(), lastY(), x(), y());
+    return line;
+}
+
+void Bullet::checkBulletCollision(BulletPool& bullets) {
+    // only the bullets whose path crosses this one around this tick can be hit; they come in the order of the pool, as the first one hit wins
+    for (std::uint32_t index : bullets.getCollisionCandidates(m_handle.index))
     {
-        if (b.getBulletId() != getBulletId() && b.m_owner != m_owner && b.isActive() && intersect(b.m_boundingLine)) {
-            m_state = HIT_BULLET;
-            m_frame = 0;
-            m_x = m_lastX;
-            m_y = m_lastY;
+        Bullet& b = bullets.m_slots[index];
+        if (b.getBulletId() != getBulletId() && b.m_owner != m_owner && b.isActive() && intersect(b.getBoundingLine())) {
+            bullets.stop(m_handle.index, HIT_BULLET);
+            setX(lastX());
+            setY(lastY());
 
-            b.m_state = HIT_BULLET;
-            b.m_frame = 0;
-            b.m_x = b.m_lastX;
-            b.m_y = b.m_lastY;
+            bullets.stop(b.m_handle.index, HIT_BULLET);
+            b.setX(b.lastX());
+            b.setY(b.lastY());
 
             // Bugfix #366
-            m_owner->addEvent( std::make_unique<BulletHitBulletEvent>( *this, b ) );
-            b.m_owner->addEvent( std::make_unique<BulletHitBulletEvent>( b, *this ) );
+            m_owner->addEvent<BulletHitBulletEvent>( bullets, m_handle, b.m_handle );
+            b.m_owner->addEvent<BulletHitBulletEvent>( bullets, b.m_handle, m_handle );
             break;
         }
     }
@@ -250,8 +292,9 @@ std::string getNameForEvent(Robot& otherRobot) {
 */
 // Workaround for http://bugs.sun.com/bugdatabase/view_bug.do?bug_id=6457965
 bool Bullet::intersect(Line2D line) {
-    double x1 = line.x1, x2 = line.x2, x3 = m_boundingLine.x1, x4 = m_boundingLine.x2;
-    double y1 = line.y1, y2 = line.y2, y3 = m_boundingLine.y1, y4 = m_boundingLine.y2;
+    Line2D boundingLine = getBoundingLine();
+    double x1 = line.x1, x2 = line.x2, x3 = boundingLine.x1, x4 = boundingLine.x2;
+    double y1 = line.y1, y2 = line.y2, y3 = boundingLine.y1, y4 = boundingLine.y2;
 
     double dx13 = (x1 - x3), dx21 = (x2 - x1), dx43 = (x4 - x3);
     double dy13 = (y1 - y3), dy21 = (y2 - y1), dy43 = (y4 - y3);
@@ -264,13 +307,17 @@ bool Bullet::intersect(Line2D line) {
     return (ua >= 0 && ua <= 1) && (ub >= 0 && ub <= 1);
 }
 
-void Bullet::checkRobotCollision(std::list<Robot*> robots) {
-    for (Robot* otherRobot : robots) {
+void Bullet::checkRobotCollision(Span<Robot*> robots, RobotGrid& grid) {
+    Line2D line = getBoundingLine();
+
+    // only the robots near the segment can be hit; they come in the order of the world, as the first one hit wins
+    for (std::uint32_t i : grid.query(std::min(line.x1, line.x2), std::min(line.y1, line.y2),
+                                      std::max(line.x1, line.x2), std::max(line.y1, line.y2))) {
+        Robot* otherRobot = robots[i];
         if (!(otherRobot == nullptr || otherRobot == m_owner || otherRobot->isDead())
-                && intersects( otherRobot->getBoundingBox(), m_boundingLine )) {
+                && intersects( otherRobot->getBoundingBox(), line )) {
 
-            m_state = HIT_VICTIM;
-            m_frame = 0;
+            m_pool->stop(m_handle.index, HIT_VICTIM);
             m_victim = otherRobot;
 
             double damage = Rules::getBulletDamage(m_power);
@@ -299,15 +346,15 @@ void Bullet::checkRobotCollision(std::list<Robot*> robots) {
 
             double newX, newY;
 
-            if (otherRobot->getBoundingBox().contains(m_lastX, m_lastY)) {
-                newX = m_lastX;
-                newY = m_lastY;
+            if (otherRobot->getBoundingBox().contains(lastX(), lastY())) {
+                newX = lastX();
+                newY = lastY();
 
                 setX(newX);
                 setY(newY);
             } else {
-                newX = m_x;
-                newY = m_y;
+                newX = x();
+                newY = y();
             }
 
             m_deltaX = newX - otherRobot->getX();
@@ -317,51 +364,3 @@ void Bullet::checkRobotCollision(std::list<Robot*> robots) {
         }
     }
 }
-
-void Bullet::checkWallCollision() {
-    if ((m_x - RADIUS <= 0) || (m_y - RADIUS <= 0) || (m_x + RADIUS >= m_world->getWidth())
-            || (m_y + RADIUS >= m_world->getHeight())) {
-        m_state = HIT_WALL;
-        m_frame = 0;
-        //m_owner->addEvent(new BulletMissedEvent(createBullet(false))); // Bugfix #366
-    }
-}
-
-void Bullet::updateBulletState() {
-    switch (m_state) {
-    case FIRED:
-        // Note that the bullet must be in the FIRED state before it goes to the MOVING state
-        if (m_frame > 0) {
-            m_state = MOVING;
-        }
-        break;
-
-    case HIT_BULLET:
-    case HIT_VICTIM:
-    case HIT_WALL:
-    case EXPLODED:
-        // Note that the bullet explosion must be ended before it goes into the INACTIVE state
-        if (m_frame >= getExplosionLength()) {
-            m_state = INACTIVE;
-        }
-        break;
-    default:
-        break;
-    }
-}
-
-void Bullet::updateMovement() {
-    m_lastX = m_x;
-    m_lastY = m_y;
-
-    double v = getVelocity();
-
-    m_x += v * sin(m_heading * Utils::toRadians);
-    m_y += v * cos(m_heading * Utils::toRadians);
-
-    m_boundingLine.setLine(m_lastX, m_lastY, m_x, m_y);
-}
-
-int Bullet::getExplosionLength() {
-    return EXPLOSION_LENGTH;
-}
\ No newline at end of file
@@ -1,15 +1,19 @@
 #pragma once
 
+#include "BulletHandle.hpp"
 #include "Rules.hpp"
+#include "Span.hpp"
 
 #include "SFML/Graphics/Color.hpp"
 #include "SFML/Graphics/RectangleShape.hpp"
 
+#include <cstdint>
 #include <string>
-#include <list>
 #include <algorithm>
 
+class BulletPool;
 class Robot;
+class RobotGrid;
 class World;
 
 struct Line2D
@@ -33,8 +37,6 @@ bool intersects( sf::FloatRect rect, Line2D line );
 class Bullet
 {
 public:
-    static std::size_t s_globalBulletId;   
-
     enum BulletState
     {
 	    /** The bullet has just been fired this turn and hence just been created. This state only last one turn. */
@@ -60,7 +62,10 @@ public:
     };
 
 
-	Bullet(Robot* owner);
+	/**
+	 * Creates a bullet whose position and state are kept by a pool, see BulletPool::add().
+	 */
+	Bullet(Robot* owner, BulletPool& pool);
 
 	int getExplosionImageIndex();
 /*
@@ -71,6 +76,13 @@ public:
 
 	int getBulletId();
 
+	/**
+	 * Returns the handle of this bullet in the pool of its world.
+	 */
+	BulletHandle getHandle() const;
+
+	void setHandle(BulletHandle handle);
+
 	int getFrame();
 
 	double getHeading();
@@ -109,9 +121,18 @@ public:
 
 	void setState(BulletState newState);
 
-	void update(std::list<Robot*> robots, std::list<Bullet> bullets);
+	/**
+	 * Checks the collisions of this bullet with robots and bullets and updates
+	 * its state, after BulletPool::move() has moved it.
+	 *
+	 * @param robots the robots of the world
+	 * @param grid the robots, listed by area, built from the same span
+	 * @param bullets the bullets of the world
+	 */
+	void update(Span<Robot*> robots, RobotGrid& grid, BulletPool& bullets);
 
 private:
+	friend class BulletPool;
 
 	static constexpr int EXPLOSION_LENGTH = 17;
 
@@ -119,35 +140,26 @@ private:
 
 	Robot* m_owner;
     World* m_world;
+    BulletPool* m_pool;
 
 	int m_bulletId;
 
-	Robot* m_victim;
+	BulletHandle m_handle;
 
-	BulletState m_state;
+	Robot* m_victim;
 
 	double m_heading;
 
-	double m_x;
-	double m_y;
-
-	double m_lastX;
-	double m_lastY;
-
 	double m_power;
 
 	double m_deltaX;
 	double m_deltaY;
 
-	Line2D m_boundingLine;
-
-	int m_frame; // Do not set to -1
-
 	sf::Color m_color;
 
 	int m_explosionImageIndex; // Do not set to -1
 
-	void checkBulletCollision(std::list<Bullet> bullets);
+	void checkBulletCollision(BulletPool& bullets);
 
 /*
 	Bullet createBullet(bool hidem_ownerName) {
@@ -169,13 +181,18 @@ private:
 	// Workaround for http://bugs.sun.com/bugdatabase/view_bug.do?bug_id=6457965
 	bool intersect(Line2D line);
 
-	void checkRobotCollision(std::list<Robot*> robots);
-
-	void checkWallCollision();
-
-	void updateBulletState();
+	void checkRobotCollision(Span<Robot*> robots, RobotGrid& grid);
 
-	void updateMovement();
+	/**
+	 * Returns the segment the bullet went along during the last tick.
+	 */
+	Line2D getBoundingLine();
 
-	int getExplosionLength();
+	// fields kept by the pool, in its arrays or from the trajectory
+	double x();
+	double y();
+	double lastX();
+	double lastY();
+	BulletState state();
+	int frame();
 };
@@ -0,0 +1,215 @@
+#include "BulletCollisionScheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    /**
+     * Slack on the crossing ticks. The crossing is computed from the same
+     * trajectories as the positions of the pool, but rounds differently from
+     * the exact test, which also accepts crossings on the ends of the
+     * segments: both are orders of magnitude below this.
+     */
+    constexpr double TICK_SLACK = 1e-3;
+
+    /** Below this sine of their angle, two bullets are handled as parallel. */
+    constexpr double PARALLEL_SINE = 1e-6;
+
+    /** Slack on the bounds of the battlefield, in pixels. */
+    constexpr double BOUNDS_SLACK = 1;
+
+    /** Crossings further away are never reached. */
+    constexpr double MAX_TICK = 1e15;
+
+    double cross( double ax, double ay, double bx, double by )
+    {
+        return ax * by - ay * bx;
+    }
+}
+
+BulletCollisionScheduler::BulletCollisionScheduler( std::size_t capacity )
+: m_now( 0 ),
+m_lastStamp( 0 ),
+m_width( std::numeric_limits<double>::infinity() ),
+m_height( std::numeric_limits<double>::infinity() ),
+m_trajectories( capacity, Trajectory() ),
+m_livePosition( capacity ),
+m_first( capacity ),
+m_last( capacity )
+{
+    m_live.reserve( capacity );
+}
+
+void BulletCollisionScheduler::schedule( std::uint32_t index, std::uint32_t order, const void* owner,
+                                         double x, double y, double dx, double dy )
+{
+    Trajectory& a = m_trajectories[index];
+    if( a.stamp == 0 )
+    {
+        m_livePosition[index] = m_live.size();
+        m_live.push_back( index );
+    }
+
+    // events of the previous trajectory no longer match the stamp
+    a.x = x;
+    a.y = y;
+    a.dx = dx;
+    a.dy = dy;
+    a.start = m_now;
+    a.stamp = ++m_lastStamp;
+    a.order = order;
+    a.owner = owner;
+
+    double speedA = std::hypot( dx, dy );
+
+    for( std::uint32_t other : m_live )
+    {
+        const Trajectory& b = m_trajectories[other];
+        if( other == index || b.owner == owner )
+            continue;
+
+        Event event;
+        event.first = index;
+        event.second = other;
+        event.firstStamp = a.stamp;
+        event.secondStamp = b.stamp;
+
+        double denominator = cross( a.dx, a.dy, b.dx, b.dy );
+        if( std::abs( denominator ) <= PARALLEL_SINE * speedA * std::hypot( b.dx, b.dy ) )
+        {
+            event.tick = 0;
+            m_parallel.push_back( event );
+            continue;
+        }
+
+        // a.x + u * a.dx = b.x + v * b.dx, likewise on y
+        double wx = b.x - a.x;
+        double wy = b.y - a.y;
+        double u = cross( wx, wy, b.dx, b.dy ) / denominator;
+        double v = cross( wx, wy, a.dx, a.dy ) / denominator;
+
+        double crossingX = a.x + u * a.dx;
+        double crossingY = a.y + u * a.dy;
+        if( crossingX < -BOUNDS_SLACK || crossingX > m_width + BOUNDS_SLACK
+                || crossingY < -BOUNDS_SLACK || crossingY > m_height + BOUNDS_SLACK )
+            continue;
+
+        // the segment of the move ending at tick t covers the trajectory from t - 1 to t
+        double timeA = double( a.start ) + u;
+        double timeB = double( b.start ) + v;
+        double first = std::max( std::ceil( std::max( timeA, timeB ) - TICK_SLACK ), double( m_now + 1 ) );
+        double last = std::floor( std::min( timeA, timeB ) + 1 + TICK_SLACK );
+        if( !( last < MAX_TICK ) )
+            continue;
+
+        for( double tick = first; tick <= last; ++tick )
+        {
+            event.tick = std::uint64_t( tick );
+            m_events.push_back( event );
+            std::push_heap( m_events.begin(), m_events.end() );
+        }
+    }
+}
+
+void BulletCollisionScheduler::remove( std::uint32_t index )
+{
+    Trajectory& trajectory = m_trajectories[index];
+    if( trajectory.stamp == 0 )
+    {
+        return;
+    }
+    trajectory.stamp = 0;
+
+    std::uint32_t position = m_livePosition[index];
+    m_live[position] = m_live.back();
+    m_livePosition[m_live[position]] = position;
+    m_live.pop_back();
+}
+
+void BulletCollisionScheduler::advance()
+{
+    ++m_now;
+
+    for( const Candidate& candidate : m_candidates )
+    {
+        m_first[candidate.index] = m_last[candidate.index] = 0;
+    }
+    m_candidates.clear();
+
+    while( !m_events.empty() && m_events.front().tick <= m_now )
+    {
+        const Event& event = m_events.front();
+        if( event.tick == m_now && isCurrent( event.first, event.firstStamp ) && isCurrent( event.second, event.secondStamp ) )
+        {
+            addCandidates( event.first, event.second );
+        }
+        std::pop_heap( m_events.begin(), m_events.end() );
+        m_events.pop_back();
+    }
+
+    m_parallel.erase( std::remove_if( m_parallel.begin(), m_parallel.end(),
+        [this]( const Event& event ) { return !isCurrent( event.first, event.firstStamp ) || !isCurrent( event.second, event.secondStamp ); } ),
+        m_parallel.end() );
+    for( const Event& event : m_parallel )
+    {
+        addCandidates( event.first, event.second );
+    }
+
+    std::sort( m_candidates.begin(), m_candidates.end() );
+    m_candidates.erase( std::unique( m_candidates.begin(), m_candidates.end() ), m_candidates.end() );
+
+    m_candidateSlots.resize( m_candidates.size() );
+    for( std::uint32_t i = 0; i < m_candidates.size(); ++i )
+    {
+        const Candidate& candidate = m_candidates[i];
+        if( m_first[candidate.index] == m_last[candidate.index] )
+        {
+            m_first[candidate.index] = i;
+        }
+        m_last[candidate.index] = i + 1;
+        m_candidateSlots[i] = candidate.other;
+    }
+}
+
+Span<const std::uint32_t> BulletCollisionScheduler::getCandidates( std::uint32_t index ) const
+{
+    return Span<const std::uint32_t>( m_candidateSlots.data() + m_first[index], m_last[index] - m_first[index] );
+}
+
+void BulletCollisionScheduler::setBounds( double width, double height )
+{
+    m_width = width;
+    m_height = height;
+}
+
+void BulletCollisionScheduler::clear()
+{
+    for( std::uint32_t index : m_live )
+    {
+        m_trajectories[index].stamp = 0;
+    }
+    m_live.clear();
+    m_events.clear();
+    m_parallel.clear();
+
+    for( const Candidate& candidate : m_candidates )
+    {
+        m_first[candidate.index] = m_last[candidate.index] = 0;
+    }
+    m_candidates.clear();
+    m_candidateSlots.clear();
+}
+
+bool BulletCollisionScheduler::isCurrent( std::uint32_t index, std::uint64_t stamp ) const
+{
+    return m_trajectories[index].stamp == stamp;
+}
+
+void BulletCollisionScheduler::addCandidates( std::uint32_t first, std::uint32_t second )
+{
+    // each bullet of the pair tests the other
+    m_candidates.push_back( Candidate{ first, m_trajectories[second].order, second } );
+    m_candidates.push_back( Candidate{ second, m_trajectories[first].order, first } );
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "Span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Kinetic scheduler of the bullet-bullet collisions.
+ *
+ * Bullets go in straight lines at a constant speed, so the tick at which
+ * the segments of two bullets may cross is known as soon as the second one
+ * is fired. schedule() computes it against every bullet in flight and queues
+ * it; advance() then hands out, for each bullet, the few bullets it may
+ * cross during the tick that just passed, which Bullet::update() tests
+ * exactly. The work per tick follows the number of crossings, not the
+ * number of pairs.
+ *
+ * The ticks are computed with some slack, so that the candidates include
+ * every pair whose segments are found to intersect, whatever the rounding of
+ * the moves. Pairs of nearly parallel bullets, whose crossing time is badly
+ * conditioned, are handed out every tick instead.
+ *
+ * Bullets are designated by their slot in the BulletPool.
+ */
+class BulletCollisionScheduler
+{
+public:
+    explicit BulletCollisionScheduler( std::size_t capacity );
+
+    /**
+     * Sets the trajectory of a bullet: `t` ticks from now, it is at
+     * (x + t * dx, y + t * dy). Replaces its previous trajectory, if any.
+     *
+     * @param index its slot
+     * @param order its rank in the order the bullets are tested in
+     * @param owner bullets of the same owner never collide
+     */
+    void schedule( std::uint32_t index, std::uint32_t order, const void* owner,
+                   double x, double y, double dx, double dy );
+
+    /**
+     * Forgets the trajectory of a bullet that stopped or was removed.
+     */
+    void remove( std::uint32_t index );
+
+    /**
+     * Tells that the bullets moved once, and collects the candidates of this tick.
+     */
+    void advance();
+
+    /**
+     * Returns the slots of the bullets that may have crossed the given one
+     * during the last tick, in the order the bullets are tested in.
+     *
+     * The span is valid until the next call to advance().
+     */
+    Span<const std::uint32_t> getCandidates( std::uint32_t index ) const;
+
+    /**
+     * Crossings outside of a width x height battlefield are not scheduled:
+     * the bullets hit a wall before.
+     */
+    void setBounds( double width, double height );
+
+    /**
+     * Forgets every trajectory.
+     */
+    void clear();
+
+    /**
+     * Returns the number of candidate pairs queued.
+     */
+    std::size_t getQueued() const { return m_events.size(); }
+
+private:
+    struct Trajectory
+    {
+        double x;
+        double y;
+        double dx;
+        double dy;
+        std::uint64_t start;
+        std::uint64_t stamp;
+        std::uint32_t order;
+        const void* owner;
+    };
+
+    struct Event
+    {
+        std::uint64_t tick;
+        std::uint32_t first;
+        std::uint32_t second;
+        std::uint64_t firstStamp;
+        std::uint64_t secondStamp;
+
+        /** For a min-heap on the tick. */
+        bool operator<( const Event& other ) const { return tick > other.tick; }
+    };
+
+    struct Candidate
+    {
+        std::uint32_t index;
+        std::uint32_t order;
+        std::uint32_t other;
+
+        bool operator<( const Candidate& c ) const { return index < c.index || ( index == c.index && order < c.order ); }
+        bool operator==( const Candidate& c ) const { return index == c.index && other == c.other; }
+    };
+
+    bool isCurrent( std::uint32_t index, std::uint64_t stamp ) const;
+    void addCandidates( std::uint32_t first, std::uint32_t second );
+
+    std::uint64_t m_now;
+    std::uint64_t m_lastStamp;
+
+    double m_width;
+    double m_height;
+
+    /** Per slot; the stamp of a slot without trajectory is 0. */
+    std::vector<Trajectory> m_trajectories;
+
+    /** Slots with a trajectory, in no particular order, and the position of each slot in it. */
+    std::vector<std::uint32_t> m_live;
+    std::vector<std::uint32_t> m_livePosition;
+
+    /** Heap of the scheduled pairs, the earliest first; kept as a vector so that clear() keeps its storage. */
+    std::vector<Event> m_events;
+
+    /** Nearly parallel pairs, handed out every tick until one of them changes. */
+    std::vector<Event> m_parallel;
+
+    /** Candidates of the last tick, sorted by slot then order. */
+    std::vector<Candidate> m_candidates;
+    std::vector<std::uint32_t> m_candidateSlots;
+
+    /** m_first[i] to m_last[i] are the candidates of slot i in m_candidateSlots. */
+    std::vector<std::uint32_t> m_first;
+    std::vector<std::uint32_t> m_last;
+};
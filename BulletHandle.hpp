@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Refers to a bullet of a BulletPool. A handle outlives its bullet: once
+ * the bullet is removed, the slot's generation changes and the handle no
+ * longer resolves, even if the slot is reused by another bullet.
+ */
+struct BulletHandle
+{
+    static constexpr std::uint32_t NONE = ~std::uint32_t( 0 );
+
+    std::uint32_t index = NONE;
+    std::uint32_t generation = 0;
+
+    bool isNull() const { return index == NONE; }
+
+    bool operator==( const BulletHandle& other ) const { return index == other.index && generation == other.generation; }
+    bool operator!=( const BulletHandle& other ) const { return !( *this == other ); }
+};
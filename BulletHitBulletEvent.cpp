@@ -1,7 +1,19 @@
 #include "BulletHitBulletEvent.hpp"
+#include "BulletPool.hpp"
 
-BulletHitBulletEvent::BulletHitBulletEvent( Bullet bullet, Bullet hitBullet )
- : m_bullet( bullet ),
+BulletHitBulletEvent::BulletHitBulletEvent( BulletPool& bullets, BulletHandle bullet, BulletHandle hitBullet )
+ : m_pBullets( &bullets ),
+ m_bullet( bullet ),
  m_hitBullet( hitBullet )
 {
-}
\ No newline at end of file
+}
+
+Bullet* BulletHitBulletEvent::getBullet()
+{
+    return m_pBullets->get( m_bullet );
+}
+
+Bullet* BulletHitBulletEvent::getHitBullet()
+{
+    return m_pBullets->get( m_hitBullet );
+}
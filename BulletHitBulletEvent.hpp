@@ -1,34 +1,44 @@
 #pragma once
 
 #include "Event.hpp"
-#include "Bullet.hpp"
+#include "BulletHandle.hpp"
+
+class Bullet;
+class BulletPool;
 
 class BulletHitBulletEvent : public Event
 {
 public:
-    BulletHitBulletEvent( Bullet bullet, Bullet hitBullet );
+	static constexpr int DEFAULT_PRIORITY = 55;
+
+    BulletHitBulletEvent( BulletPool& bullets, BulletHandle bullet, BulletHandle hitBullet );
 
 	/**
 	 * Returns your bullet that hit another bullet.
 	 *
-	 * @return your bullet
+	 * @return your bullet, or nullptr if it has left the battlefield since
 	 */
-	Bullet getBullet()
-    {
-		return m_bullet;
-	}
+	Bullet* getBullet();
 
 	/**
 	 * Returns the bullet that was hit by your bullet.
 	 *
-	 * @return the bullet that was hit
+	 * @return the bullet that was hit, or nullptr if it has left the battlefield since
 	 */
-	Bullet getHitBullet()
+	Bullet* getHitBullet();
+
+	BulletHandle getBulletHandle() const
+    {
+		return m_bullet;
+	}
+
+	BulletHandle getHitBulletHandle() const
     {
 		return m_hitBullet;
 	}
 
 private:
-    Bullet m_bullet;
-    Bullet m_hitBullet;
-};
\ No newline at end of file
+    BulletPool* m_pBullets;
+    BulletHandle m_bullet;
+    BulletHandle m_hitBullet;
+};
@@ -0,0 +1,366 @@
+#include "BulletPool.hpp"
+
+#include "SinCos.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /** Flights longer than this never reach a wall: the bullet does not move. */
+    constexpr double MAX_FLIGHT = 1e15;
+}
+
+BulletPool::BulletPool( std::size_t capacity, double width, double height )
+: m_capacity( capacity ),
+m_width( width ),
+m_height( height ),
+m_tick( 0 ),
+m_originX( capacity ),
+m_originY( capacity ),
+m_start( capacity ),
+m_dx( capacity ),
+m_dy( capacity ),
+m_x( capacity ),
+m_y( capacity ),
+m_lastX( capacity ),
+m_lastY( capacity ),
+m_state( capacity, Bullet::INACTIVE ),
+m_frameStart( capacity ),
+m_stamps( capacity ),
+m_wheel( WHEEL_SIZE ),
+m_collisions( capacity )
+{
+    m_slots.reserve( capacity );
+    m_generations.reserve( capacity );
+    m_free.reserve( capacity );
+    m_active.reserve( capacity );
+    m_collisions.setBounds( width, height );
+}
+
+BulletHandle BulletPool::add( Robot* owner, double power, double heading, double x, double y )
+{
+    if( full() )
+    {
+        return BulletHandle();
+    }
+
+    std::uint32_t index;
+    if( !m_free.empty() )
+    {
+        index = m_free.back();
+        m_free.pop_back();
+        m_slots[index] = Bullet( owner, *this );
+    }
+    else
+    {
+        index = m_slots.size();
+        m_slots.push_back( Bullet( owner, *this ) );
+        m_generations.push_back( 0 );
+    }
+    m_active.push_back( index );
+
+    BulletHandle handle;
+    handle.index = index;
+    handle.generation = m_generations[index];
+
+    Bullet& bullet = m_slots[index];
+    bullet.m_handle = handle;
+    bullet.m_power = power;
+    bullet.m_heading = heading;
+
+    m_originX[index] = x;
+    m_originY[index] = y;
+    m_start[index] = m_tick;
+    m_state[index] = Bullet::FIRED;
+    m_frameStart[index] = m_tick;
+    updateVelocity( index );
+
+    return handle;
+}
+
+Bullet* BulletPool::get( BulletHandle handle )
+{
+    if( handle.index >= m_slots.size() || m_generations[handle.index] != handle.generation )
+    {
+        return nullptr;
+    }
+    return &m_slots[handle.index];
+}
+
+double BulletPool::getX( std::uint32_t index ) const
+{
+    return inFlight( index ) ? m_originX[index] + flightTicks( index ) * m_dx[index] : m_x[index];
+}
+
+double BulletPool::getY( std::uint32_t index ) const
+{
+    return inFlight( index ) ? m_originY[index] + flightTicks( index ) * m_dy[index] : m_y[index];
+}
+
+double BulletPool::getLastX( std::uint32_t index ) const
+{
+    if( !inFlight( index ) )
+        return m_lastX[index];
+    // where it was before the last move, or where it started
+    return m_originX[index] + std::max( flightTicks( index ) - 1, 0.0 ) * m_dx[index];
+}
+
+double BulletPool::getLastY( std::uint32_t index ) const
+{
+    if( !inFlight( index ) )
+        return m_lastY[index];
+    return m_originY[index] + std::max( flightTicks( index ) - 1, 0.0 ) * m_dy[index];
+}
+
+Bullet::BulletState BulletPool::getState( std::uint32_t index ) const
+{
+    // a bullet is FIRED until its first move
+    if( m_state[index] == Bullet::FIRED && getFrame( index ) > 0 )
+    {
+        return Bullet::MOVING;
+    }
+    return Bullet::BulletState( m_state[index] );
+}
+
+void BulletPool::updateVelocity( std::uint32_t index )
+{
+    const Bullet& bullet = m_slots[index];
+    double v = Rules::getBulletSpeed( bullet.m_power );
+
+    SinCos heading( bullet.m_heading * Utils::toRadians );
+    m_dx[index] = v * heading.sin();
+    m_dy[index] = v * heading.cos();
+
+    updateTrajectory( index );
+}
+
+bool BulletPool::isAtWall( std::uint32_t index, double ticks ) const
+{
+    const double radius = Bullet::RADIUS;
+
+    // same expressions as getX() and getY(), so that both round the same way
+    double x = m_originX[index] + ticks * m_dx[index];
+    double y = m_originY[index] + ticks * m_dy[index];
+    return x - radius <= 0 || y - radius <= 0 || x + radius >= m_width || y + radius >= m_height;
+}
+
+void BulletPool::updateTrajectory( std::uint32_t index )
+{
+    if( !inFlight( index ) )
+    {
+        m_collisions.remove( index );
+        return;
+    }
+
+    // the flight starts over from here
+    m_originX[index] = getX( index );
+    m_originY[index] = getY( index );
+    m_start[index] = m_tick;
+    ++m_stamps[index];
+
+    // the first move that reaches a wall: estimated on each axis, then
+    // adjusted to the rounding of the positions
+    const double radius = Bullet::RADIUS;
+    double dx = m_dx[index];
+    double dy = m_dy[index];
+    double ticks = MAX_FLIGHT;
+    if( dx > 0 )
+        ticks = std::min( ticks, ( m_width - radius - m_originX[index] ) / dx );
+    else if( dx < 0 )
+        ticks = std::min( ticks, ( m_originX[index] - radius ) / -dx );
+    if( dy > 0 )
+        ticks = std::min( ticks, ( m_height - radius - m_originY[index] ) / dy );
+    else if( dy < 0 )
+        ticks = std::min( ticks, ( m_originY[index] - radius ) / -dy );
+    ticks = std::max( std::ceil( ticks ), 1.0 );
+    if( isAtWall( index, 1 ) )
+        ticks = 1;
+
+    if( ticks < MAX_FLIGHT )
+    {
+        while( ticks > 1 && isAtWall( index, ticks - 1 ) )
+            --ticks;
+        while( !isAtWall( index, ticks ) )
+            ++ticks;
+        addTimer( index, m_tick + std::uint64_t( ticks ), WALL );
+    }
+
+    const Bullet& bullet = m_slots[index];
+    // the bullets are tested in the order they were added, i.e. of their ids
+    m_collisions.schedule( index, std::uint32_t( bullet.m_bulletId ), bullet.m_owner,
+                           m_originX[index], m_originY[index], dx, dy );
+}
+
+void BulletPool::setX( std::uint32_t index, double x )
+{
+    if( inFlight( index ) )
+    {
+        m_originX[index] = x;
+        m_originY[index] = getY( index );
+        m_start[index] = m_tick;
+        updateTrajectory( index );
+    }
+    else
+    {
+        m_x[index] = m_lastX[index] = x;
+    }
+}
+
+void BulletPool::setY( std::uint32_t index, double y )
+{
+    if( inFlight( index ) )
+    {
+        m_originX[index] = getX( index );
+        m_originY[index] = y;
+        m_start[index] = m_tick;
+        updateTrajectory( index );
+    }
+    else
+    {
+        m_y[index] = m_lastY[index] = y;
+    }
+}
+
+void BulletPool::setState( std::uint32_t index, Bullet::BulletState state )
+{
+    if( state == Bullet::FIRED || state == Bullet::MOVING )
+    {
+        if( !inFlight( index ) )
+        {
+            // takes off from where it stopped
+            m_originX[index] = m_x[index];
+            m_originY[index] = m_y[index];
+            m_start[index] = m_tick;
+            m_state[index] = Bullet::FIRED;
+            updateTrajectory( index );
+        }
+    }
+    else if( inFlight( index ) )
+    {
+        stop( index, state, false );
+    }
+    else
+    {
+        m_state[index] = state;
+    }
+}
+
+void BulletPool::stop( std::uint32_t index, Bullet::BulletState state, bool restartFrame /*= true*/ )
+{
+    m_x[index] = getX( index );
+    m_y[index] = getY( index );
+    m_lastX[index] = getLastX( index );
+    m_lastY[index] = getLastY( index );
+    m_state[index] = state;
+    ++m_stamps[index];
+    m_collisions.remove( index );
+
+    if( restartFrame )
+    {
+        m_frameStart[index] = m_tick;
+    }
+
+    if( state != Bullet::INACTIVE )
+    {
+        std::uint64_t end = m_frameStart[index] + Bullet::EXPLOSION_LENGTH;
+        if( end > m_tick )
+            addTimer( index, end, EXPLOSION_END );
+        else
+            m_state[index] = Bullet::INACTIVE;
+    }
+}
+
+void BulletPool::addTimer( std::uint32_t index, std::uint64_t tick, TimerKind kind )
+{
+    Timer timer;
+    timer.tick = tick;
+    timer.stamp = m_stamps[index];
+    timer.index = index;
+    timer.kind = kind;
+    m_wheel[tick % WHEEL_SIZE].push_back( timer );
+}
+
+void BulletPool::move()
+{
+    ++m_tick;
+
+    // the timers of this slot of the wheel that are due now; the others wait for their turn
+    std::vector<Timer>& timers = m_wheel[m_tick % WHEEL_SIZE];
+    m_due.clear();
+    auto out = timers.begin();
+    for( const Timer& timer : timers )
+    {
+        if( timer.tick == m_tick )
+            m_due.push_back( timer );
+        else if( timer.tick > m_tick )
+            *out++ = timer;
+    }
+    timers.erase( out, timers.end() );
+
+    for( const Timer& timer : m_due )
+    {
+        // the bullet stopped, flew off again or was removed since
+        if( m_stamps[timer.index] != timer.stamp )
+            continue;
+
+        switch( timer.kind )
+        {
+        case WALL:
+            stop( timer.index, Bullet::HIT_WALL );
+            break;
+        case EXPLOSION_END:
+            m_state[timer.index] = Bullet::INACTIVE;
+            break;
+        }
+    }
+
+    m_collisions.advance();
+}
+
+void BulletPool::release( std::uint32_t index )
+{
+    // handles to the removed bullet no longer match
+    ++m_generations[index];
+    ++m_stamps[index];
+    m_state[index] = Bullet::INACTIVE;
+    m_collisions.remove( index );
+    m_free.push_back( index );
+}
+
+void BulletPool::removeInactive()
+{
+    auto out = m_active.begin();
+    for( std::uint32_t index : m_active )
+    {
+        if( m_state[index] == Bullet::INACTIVE )
+            release( index );
+        else
+            *out++ = index;
+    }
+    m_active.erase( out, m_active.end() );
+}
+
+void BulletPool::clear()
+{
+    for( std::uint32_t index : m_active )
+    {
+        ++m_generations[index];
+        ++m_stamps[index];
+        m_state[index] = Bullet::INACTIVE;
+    }
+    m_active.clear();
+    m_collisions.clear();
+    for( std::vector<Timer>& timers : m_wheel )
+    {
+        timers.clear();
+    }
+
+    // hand out the slots in order again, so that a round does not depend on the previous ones
+    m_free.clear();
+    for( std::size_t index = m_slots.size(); index-- > 0; )
+    {
+        m_free.push_back( index );
+    }
+}
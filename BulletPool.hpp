@@ -0,0 +1,235 @@
+#pragma once
+
+#include "Bullet.hpp"
+#include "BulletCollisionScheduler.hpp"
+#include "BulletHandle.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Robot;
+
+/**
+ * Fixed-capacity, contiguous storage for the bullets of a World.
+ *
+ * Slots are allocated once and reused through a free list, so firing does
+ * not allocate. Bullets are iterated in the order they were added, whatever
+ * slots they occupy, which keeps the simulation independent of the reuse.
+ *
+ * A bullet in flight goes in a straight line at a constant speed: the pool
+ * keeps where and when its flight started, and computes its position from
+ * the number of ticks since, instead of moving it every tick. The tick at
+ * which it reaches a wall is known when it is fired, as is the tick at which
+ * an explosion ends, and both are kept in a timing wheel: move() only
+ * touches the bullets due. What every bullet needs is stored apart from the
+ * Bullet objects, one array per field indexed by slot; the Bullet objects
+ * only keep the rest and read their fields from here.
+ *
+ * The pool also keeps the trajectories of the bullets in flight, to hand
+ * out the pairs of bullets that may collide during a tick.
+ */
+class BulletPool
+{
+public:
+    /**
+     * Iterates over the bullets in the pool, in the order they were added.
+     * Invalidated when a bullet is added or removed.
+     */
+    class iterator
+    {
+    public:
+        iterator( std::vector<Bullet>& slots, const std::uint32_t* pIndex )
+        : m_pSlots( &slots ),
+        m_pIndex( pIndex )
+        {
+        }
+
+        Bullet& operator*() const { return ( *m_pSlots )[*m_pIndex]; }
+        Bullet* operator->() const { return &( *m_pSlots )[*m_pIndex]; }
+        iterator& operator++() { ++m_pIndex; return *this; }
+        bool operator==( const iterator& other ) const { return m_pIndex == other.m_pIndex; }
+        bool operator!=( const iterator& other ) const { return m_pIndex != other.m_pIndex; }
+
+    private:
+        std::vector<Bullet>* m_pSlots;
+        const std::uint32_t* m_pIndex;
+    };
+
+    /**
+     * @param capacity the number of bullets that can be in the pool at the same time
+     * @param width the width of the battlefield
+     * @param height the height of the battlefield
+     */
+    BulletPool( std::size_t capacity, double width, double height );
+
+    BulletPool( const BulletPool& ) = delete;
+    BulletPool& operator=( const BulletPool& ) = delete;
+
+    /**
+     * Fires a new bullet from a free slot.
+     *
+     * @param owner the robot firing it
+     * @param power its power
+     * @param heading its heading, in degrees
+     * @param x its initial position
+     * @param y its initial position
+     * @return the handle of the new bullet, or a null handle if the pool is full
+     */
+    BulletHandle add( Robot* owner, double power, double heading, double x, double y );
+
+    /**
+     * Returns the bullet a handle refers to.
+     *
+     * @return the bullet, or nullptr if it has been removed
+     */
+    Bullet* get( BulletHandle handle );
+
+    /**
+     * Advances the bullets by one tick: the ones in flight move, those that
+     * reach a wall stop, and the explosions that are over end. Collisions
+     * with robots and other bullets are left to Bullet::update().
+     */
+    void move();
+
+    /**
+     * Removes the bullets whose explosion has ended, i.e. the INACTIVE ones.
+     */
+    void removeInactive();
+
+    /**
+     * Removes every bullet.
+     */
+    void clear();
+
+    iterator begin() { return iterator( m_slots, m_active.data() ); }
+    iterator end() { return iterator( m_slots, m_active.data() + m_active.size() ); }
+
+    std::size_t size() const { return m_active.size(); }
+    std::size_t capacity() const { return m_capacity; }
+
+    /** Number of calls to move() so far. */
+    std::uint64_t getTick() const { return m_tick; }
+    bool full() const { return m_active.size() == m_capacity; }
+
+private:
+    friend class Bullet;
+
+    enum TimerKind
+    {
+        /** A bullet in flight reaches a wall. */
+        WALL,
+
+        /** The explosion of a bullet that hit something ends. */
+        EXPLOSION_END
+    };
+
+    struct Timer
+    {
+        std::uint64_t tick;
+        std::uint64_t stamp;
+        std::uint32_t index;
+        TimerKind kind;
+    };
+
+    /** Slots of the timing wheel; a timer further away than that waits for the next turn of the wheel. */
+    static constexpr std::size_t WHEEL_SIZE = 256;
+
+    void release( std::uint32_t index );
+
+    bool inFlight( std::uint32_t index ) const { return m_state[index] == Bullet::FIRED; }
+
+    /** Number of moves since the flight of a slot started. */
+    double flightTicks( std::uint32_t index ) const { return double( m_tick - m_start[index] ); }
+
+    // positions of a slot, whether in flight or stopped
+    double getX( std::uint32_t index ) const;
+    double getY( std::uint32_t index ) const;
+    double getLastX( std::uint32_t index ) const;
+    double getLastY( std::uint32_t index ) const;
+
+    Bullet::BulletState getState( std::uint32_t index ) const;
+    int getFrame( std::uint32_t index ) const { return int( m_tick - m_frameStart[index] ); }
+
+    /**
+     * Sets the velocity of a slot from the heading and power of its bullet.
+     */
+    void updateVelocity( std::uint32_t index );
+
+    /**
+     * Starts the flight of a slot over from where it is now: schedules the
+     * wall it will reach and its collisions with the other bullets.
+     */
+    void updateTrajectory( std::uint32_t index );
+
+    /**
+     * Moves a slot on one axis, like Bullet::setX() and Bullet::setY(): stopped,
+     * it stays there; in flight, it flies on from there.
+     */
+    void setX( std::uint32_t index, double x );
+    void setY( std::uint32_t index, double y );
+
+    /**
+     * Sets the state of a slot, stopping it or starting its flight over as needed.
+     */
+    void setState( std::uint32_t index, Bullet::BulletState state );
+
+    /**
+     * Stops a bullet in flight where it is, in the given state, and starts
+     * its explosion, from its first frame unless told otherwise.
+     */
+    void stop( std::uint32_t index, Bullet::BulletState state, bool restartFrame = true );
+
+    void addTimer( std::uint32_t index, std::uint64_t tick, TimerKind kind );
+
+    /**
+     * Returns whether a slot in flight is against a wall after the given number of moves.
+     */
+    bool isAtWall( std::uint32_t index, double ticks ) const;
+
+    /**
+     * Returns the slots of the bullets that may have collided with the bullet
+     * in the given slot during the last move(), in the order of the pool.
+     */
+    Span<const std::uint32_t> getCollisionCandidates( std::uint32_t index ) const
+    {
+        return m_collisions.getCandidates( index );
+    }
+
+    std::size_t m_capacity;
+    double m_width;
+    double m_height;
+    std::uint64_t m_tick;
+
+    /** Reserved to the capacity up front: never reallocates. */
+    std::vector<Bullet> m_slots;
+    std::vector<std::uint32_t> m_generations;
+
+    /** Free slots, the next one to use at the back. */
+    std::vector<std::uint32_t> m_free;
+
+    /** Occupied slots, in the order their bullets were added. */
+    std::vector<std::uint32_t> m_active;
+
+    // per slot; free slots are INACTIVE, and FIRED stands for in flight
+    std::vector<double> m_originX;
+    std::vector<double> m_originY;
+    std::vector<std::uint64_t> m_start;
+    std::vector<double> m_dx;
+    std::vector<double> m_dy;
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_lastX;
+    std::vector<double> m_lastY;
+    std::vector<std::int32_t> m_state;
+    std::vector<std::uint64_t> m_frameStart;
+
+    /** Changes when a slot starts a flight, stops or is released, so that its old timers no longer match. */
+    std::vector<std::uint64_t> m_stamps;
+
+    /** Timers by tick modulo WHEEL_SIZE, and the ones being fired. */
+    std::vector<std::vector<Timer>> m_wheel;
+    std::vector<Timer> m_due;
+
+    BulletCollisionScheduler m_collisions;
+};
\ No newline at end of file
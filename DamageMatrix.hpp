@@ -0,0 +1,81 @@
+#pragma once
+
+#include "RobotNameTable.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+/**
+ * The damage each robot of a battle dealt to each other robot during the
+ * current round, as a dense matrix indexed by robot id: the kill bonuses
+ * read it in O(1), and clear() starts a new round with a single memset.
+ */
+class DamageMatrix
+{
+public:
+    DamageMatrix()
+    : m_size( 0 )
+    {
+    }
+
+    /**
+     * Makes room for the given number of robots, keeping the damage so far.
+     */
+    void fit( std::size_t numRobots )
+    {
+        if( numRobots <= m_size )
+        {
+            return;
+        }
+
+        std::vector<double> damage( numRobots * numRobots, 0. );
+        for( std::size_t from = 0; from < m_size; ++from )
+        {
+            std::memcpy( &damage[from * numRobots], &m_damage[from * m_size], m_size * sizeof( double ) );
+        }
+        m_damage.swap( damage );
+        m_size = numRobots;
+    }
+
+    /**
+     * Forgets all the damage, e.g. at the beginning of a round.
+     */
+    void clear()
+    {
+        if( !m_damage.empty() )
+        {
+            std::memset( m_damage.data(), 0, m_damage.size() * sizeof( double ) );
+        }
+    }
+
+    /**
+     * Forgets the damage dealt by a robot.
+     */
+    void clearRow( RobotId from )
+    {
+        if( from < m_size )
+        {
+            std::memset( &m_damage[from * m_size], 0, m_size * sizeof( double ) );
+        }
+    }
+
+    void add( RobotId from, RobotId to, double damage )
+    {
+        m_damage[from * m_size + to] += damage;
+    }
+
+    double get( RobotId from, RobotId to ) const
+    {
+        return m_damage[from * m_size + to];
+    }
+
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+private:
+    std::size_t m_size;
+    std::vector<double> m_damage;
+};
@@ -19,6 +19,7 @@
 class DeathEvent : public Event
 {
 public:
+	static constexpr int DEFAULT_PRIORITY = -1;
 
 	/**
 	 * Called by the game to create a new DeathEvent.
@@ -1,7 +1,10 @@
 #pragma once 
 
+/**
+ * The base of the events sent to a robot. Events are stored by value in the
+ * robot's EventQueue, and each one gives its DEFAULT_PRIORITY: higher
+ * priority events are delivered first.
+ */
 class Event
 {
-public:
-    virtual ~Event() {}
 };
\ No newline at end of file
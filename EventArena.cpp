@@ -0,0 +1,45 @@
+#include "EventArena.hpp"
+
+#include <cassert>
+
+EventArena::EventArena()
+: m_buffers{ { {}, 0, 0 }, { {}, 0, 0 } },
+m_generation( 0 ),
+m_allocationCount( 0 ),
+m_eventCount( 0 )
+{
+}
+
+void EventArena::flip()
+{
+    ++m_generation;
+
+    Buffer& buffer = m_buffers[m_generation & 1];
+    buffer.page = 0;
+    buffer.offset = 0;
+}
+
+void* EventArena::allocate( std::size_t size, std::size_t alignment )
+{
+    assert( size <= PAGE_SIZE && alignment <= alignof( std::max_align_t ) );
+
+    Buffer& buffer = m_buffers[m_generation & 1];
+    for( ;; )
+    {
+        if( buffer.page == buffer.pages.size() )
+        {
+            buffer.pages.emplace_back( new std::byte[PAGE_SIZE] );
+            ++m_allocationCount;
+        }
+
+        std::size_t offset = ( buffer.offset + alignment - 1 ) & ~( alignment - 1 );
+        if( offset + size <= PAGE_SIZE )
+        {
+            buffer.offset = offset + size;
+            return buffer.pages[buffer.page].get() + offset;
+        }
+
+        ++buffer.page;
+        buffer.offset = 0;
+    }
+}
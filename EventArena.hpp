@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Storage of the robot events of a World, from one tick to the next.
+ *
+ * Events are bump-allocated in the buffer of the current generation. An
+ * event is delivered at the latest on the tick after it was created, so
+ * flip() starts a new generation by recycling, in O(1), the buffer of the
+ * generation before the previous one. The pages of the buffers are kept,
+ * so that once they have grown the events allocate nothing; the number of
+ * allocations made on behalf of the events is counted to check it.
+ *
+ * Only trivially destructible objects are stored: recycling a buffer does
+ * not run any destructor.
+ */
+class EventArena
+{
+public:
+    EventArena();
+
+    /**
+     * Constructs an object in the current generation.
+     */
+    template<typename T, typename... Args>
+    T* create( Args&&... args )
+    {
+        static_assert( std::is_trivially_destructible<T>::value, "the arena does not destroy what it stores" );
+        ++m_eventCount;
+        return new( allocate( sizeof( T ), alignof( T ) ) ) T( std::forward<Args>( args )... );
+    }
+
+    /**
+     * Starts a new generation, recycling the buffer of the generation before
+     * the current one. Objects of that generation still needed must have
+     * been copied into the current one with isRecycledByFlip() and create().
+     */
+    void flip();
+
+    /**
+     * Returns whether the objects of the given generation are recycled by
+     * the next flip().
+     */
+    bool isRecycledByFlip( std::uint64_t generation ) const { return generation < m_generation; }
+
+    std::uint64_t getGeneration() const { return m_generation; }
+
+    /**
+     * Counts an allocation made on behalf of the events outside of the
+     * arena, e.g. by a queue of event pointers growing.
+     */
+    void countAllocation() { ++m_allocationCount; }
+
+    /**
+     * Returns the number of allocations made for the events so far: the
+     * pages of the arena and those given to countAllocation().
+     */
+    std::uint64_t getAllocationCount() const { return m_allocationCount; }
+
+    /**
+     * Returns the number of objects created so far.
+     */
+    std::uint64_t getEventCount() const { return m_eventCount; }
+
+private:
+    static constexpr std::size_t PAGE_SIZE = 64 * 1024;
+
+    struct Buffer
+    {
+        std::vector<std::unique_ptr<std::byte[]>> pages;
+        std::size_t page;
+        std::size_t offset;
+    };
+
+    void* allocate( std::size_t size, std::size_t alignment );
+
+    Buffer m_buffers[2];
+    std::uint64_t m_generation;
+    std::uint64_t m_allocationCount;
+    std::uint64_t m_eventCount;
+};
@@ -0,0 +1,87 @@
+#include "EventQueue.hpp"
+
+#include <algorithm>
+
+static_assert( std::is_same_v<std::variant_alternative_t<EventQueue::SCANNED_ROBOT, EventQueue::Payload>, ScannedRobotEvent> &&
+               std::is_same_v<std::variant_alternative_t<EventQueue::BATTLE_ENDED, EventQueue::Payload>, BattleEndedEvent>,
+               "EventQueue::Type must follow the alternatives of EventQueue::Payload" );
+
+bool EventQueue::Entry::operator<( const Entry& other ) const
+{
+    if( m_priority != other.m_priority )
+    {
+        return m_priority > other.m_priority;
+    }
+
+    if( m_event.index() == other.m_event.index() )
+    {
+        switch( getType() )
+        {
+            case SCANNED_ROBOT:
+            {
+                int res = get<ScannedRobotEvent>().compareTo( other.get<ScannedRobotEvent>() );
+                if( res != 0 )
+                {
+                    return res < 0;
+                }
+                break;
+            }
+            case HIT_ROBOT:
+            {
+                int res = get<HitRobotEvent>().compareTo( other.get<HitRobotEvent>() );
+                if( res != 0 )
+                {
+                    return res < 0;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return m_sequence < other.m_sequence;
+}
+
+EventQueue::EventQueue( EventArena& arena )
+: m_pArena( &arena ),
+m_generation( 0 )
+{
+    // enough for the robots a sweep of the radar usually finds in a melee
+    m_entries.reserve( INITIAL_CAPACITY );
+    m_pArena->countAllocation();
+}
+
+void EventQueue::retain()
+{
+    if( m_entries.empty() || !m_pArena->isRecycledByFlip( m_generation ) )
+    {
+        return;
+    }
+
+    for( Entry*& entry : m_entries )
+    {
+        entry = m_pArena->create<Entry>( *entry );
+    }
+    m_generation = m_pArena->getGeneration();
+}
+
+void EventQueue::sort()
+{
+    auto inDeliveryOrder = []( const Entry* a, const Entry* b ) { return *a < *b; };
+
+    // most ticks the events were added in order already
+    if( !std::is_sorted( m_entries.begin(), m_entries.end(), inDeliveryOrder ) )
+    {
+        std::sort( m_entries.begin(), m_entries.end(), inDeliveryOrder );
+    }
+}
+
+void EventQueue::push( Entry* entry )
+{
+    if( m_entries.size() == m_entries.capacity() )
+    {
+        m_pArena->countAllocation();
+    }
+    m_entries.push_back( entry );
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "BulletHitBulletEvent.hpp"
+#include "DeathEvent.hpp"
+#include "HitRobotEvent.hpp"
+#include "HitWallEvent.hpp"
+#include "ScannedRobotEvent.hpp"
+#include "RoundEndedEvent.hpp"
+#include "BattleEndedEvent.hpp"
+#include "EventArena.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/**
+ * The events waiting to be delivered to a robot.
+ *
+ * The events are tagged with their type and constructed in the EventArena of
+ * the World; the queue lists them in a buffer that keeps its capacity from one
+ * tick to the next, so that adding an event allocates nothing once the buffer
+ * has grown, and delivering it is a switch on the tag. sort() puts them in the
+ * order Robocode delivers them: higher priority first, then the closer scanned
+ * robot, or the hit robot we were at fault for, then the order they were
+ * added in.
+ */
+class EventQueue
+{
+public:
+    /**
+     * The type of an event, in the order of the alternatives of Payload.
+     */
+    enum Type : std::uint8_t
+    {
+        BULLET_HIT_BULLET,
+        DEATH,
+        HIT_ROBOT,
+        HIT_WALL,
+        SCANNED_ROBOT,
+        ROUND_ENDED,
+        BATTLE_ENDED
+    };
+
+    using Payload = std::variant<BulletHitBulletEvent, DeathEvent, HitRobotEvent, HitWallEvent,
+                                 ScannedRobotEvent, RoundEndedEvent, BattleEndedEvent>;
+
+    class Entry
+    {
+    public:
+        template<typename T, typename... Args>
+        Entry( std::in_place_type_t<T> type, std::uint32_t sequence, Args&&... args )
+        : m_event( type, std::forward<Args>( args )... ),
+        m_priority( T::DEFAULT_PRIORITY ),
+        m_sequence( sequence )
+        {
+        }
+
+        Type getType() const { return Type( m_event.index() ); }
+
+        int getPriority() const { return m_priority; }
+
+        /**
+         * Returns the event, which must be of the type given by getType().
+         */
+        template<typename T>
+        T& get() { return *std::get_if<T>( &m_event ); }
+
+        template<typename T>
+        const T& get() const { return *std::get_if<T>( &m_event ); }
+
+        /**
+         * Returns whether this event is delivered before the other one.
+         */
+        bool operator<( const Entry& other ) const;
+
+    private:
+        Payload m_event;
+        int m_priority;
+        std::uint32_t m_sequence;
+    };
+
+    explicit EventQueue( EventArena& arena );
+
+    /**
+     * Constructs an event of type T in the arena, at the end of the queue.
+     */
+    template<typename T, typename... Args>
+    void add( Args&&... args )
+    {
+        if( m_entries.empty() )
+        {
+            m_generation = m_pArena->getGeneration();
+        }
+        push( m_pArena->create<Entry>( std::in_place_type<T>, std::uint32_t( m_entries.size() ), std::forward<Args>( args )... ) );
+    }
+
+    /**
+     * Copies the events into the current generation of the arena if its next
+     * flip would recycle them, e.g. because the robot left the world before
+     * they could be delivered.
+     */
+    void retain();
+
+    /**
+     * Puts the events in delivery order.
+     */
+    void sort();
+
+    /**
+     * Removes the events, keeping the buffer.
+     */
+    void clear() { m_entries.clear(); }
+
+    void swap( EventQueue& other )
+    {
+        m_entries.swap( other.m_entries );
+        std::swap( m_generation, other.m_generation );
+    }
+
+    bool empty() const { return m_entries.empty(); }
+    std::size_t size() const { return m_entries.size(); }
+
+    std::vector<Entry*>::iterator begin() { return m_entries.begin(); }
+    std::vector<Entry*>::iterator end() { return m_entries.end(); }
+
+private:
+    static constexpr std::size_t INITIAL_CAPACITY = 32;
+
+    void push( Entry* entry );
+
+    EventArena* m_pArena;
+    std::vector<Entry*> m_entries;
+
+    /** The generation of the oldest event. */
+    std::uint64_t m_generation;
+};
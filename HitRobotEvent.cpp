@@ -1,7 +1,8 @@
 #include "HitRobotEvent.hpp"
 
-HitRobotEvent::HitRobotEvent( std::string name, double bearing, double energy, bool atFault )
- : m_robotName( name ),
+HitRobotEvent::HitRobotEvent( const RobotNameTable& names, RobotId robot, double bearing, double energy, bool atFault )
+ : m_pNames( &names ),
+ m_robot( robot ),
  m_bearing( bearing ),
  m_energy( energy ),
  m_atFault( atFault )
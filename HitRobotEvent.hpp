@@ -1,21 +1,27 @@
 #pragma once
 
 #include "Event.hpp"
+#include "RobotNameTable.hpp"
 #include "Utils.hpp"
 
+#include <string>
+
 class HitRobotEvent : public Event
 {
 public:
+	static constexpr int DEFAULT_PRIORITY = 40;
+
 	/**
 	 * Called by the game to create a new HitRobotEvent.
 	 *
-	 * @param name	the name of the robot you hit
+	 * @param names	the robots of the battle
+	 * @param robot	the id of the robot you hit
 	 * @param bearing the bearing to the robot that your robot hit, in radians
 	 * @param energy  the amount of energy of the robot you hit
 	 * @param atFault {@code true} if your robot was moving toward the other
 	 *                robot; {@code false} otherwise
 	 */
-    HitRobotEvent( std::string name, double bearing, double energy, bool atFault );
+    HitRobotEvent( const RobotNameTable& names, RobotId robot, double bearing, double energy, bool atFault );
 
 	/**
 	 * Returns the bearing to the robot you hit, relative to your robot's
@@ -63,18 +69,28 @@ public:
 	 *
 	 * @return the name of the robot you hit
 	 */
-	std::string getName()
+	const std::string& getName()
 	{
-		return m_robotName;
+		return m_pNames->getName( m_robot );
+	}
+
+	/**
+	 * Returns the id of the robot you hit, within the battle.
+	 *
+	 * @return the id of the robot you hit
+	 */
+	RobotId getRobotId() const
+	{
+		return m_robot;
 	}
 
 	/**
 	 * @return the name of the robot you hit
 	 * @deprecated Use {@link #getName()} instead.
 	 */
-	std::string getRobotName()
+	const std::string& getRobotName()
 	{
-		return m_robotName;
+		return getName();
 	}
 
 	/**
@@ -90,7 +106,7 @@ public:
 	 * @return {@code true} if your robot was moving towards the robot that was
 	 *         hit; {@code false} otherwise.
 	 */
-	bool isMyFault()
+	bool isMyFault() const
 	{
 		return m_atFault;
 	}
@@ -98,32 +114,19 @@ public:
 	/**
 	 * {@inheritDoc}
 	 */
-	int compareTo( Event* event )
+	int compareTo( const HitRobotEvent& event ) const
 	{
-		int res = 0; //Event::compareTo(event);
-
-		if( res != 0 )
-		{
-			return res;
-		}
-
-		// Compare the isMyFault, if the events are HitRobotEvents
+		// Compare the isMyFault
 		// The isMyFault has higher priority when it is set compared to when it is not set
-		auto pHre = dynamic_cast<HitRobotEvent*>( event );
-		if( pHre != nullptr )
-		{
-			int compare1 = isMyFault() ? -1 : 0;
-			int compare2 = pHre->isMyFault() ? -1 : 0;
-
-			return compare1 - compare2;
-		}
+		int compare1 = isMyFault() ? -1 : 0;
+		int compare2 = event.isMyFault() ? -1 : 0;
 
-		// No difference found
-		return 0;
+		return compare1 - compare2;
 	}
 
 private:
-	std::string m_robotName;
+	const RobotNameTable* m_pNames;
+	RobotId m_robot;
 	double m_bearing;
 	double m_energy;
 	bool m_atFault;
@@ -6,6 +6,8 @@
 class HitWallEvent : public Event
 {
 public:
+	static constexpr int DEFAULT_PRIORITY = 30;
+
     HitWallEvent( double bearing );
 
 	/**
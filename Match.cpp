@@ -0,0 +1,55 @@
+#include "Match.hpp"
+#include "RandomStream.hpp"
+
+#include <algorithm>
+
+Match::Match( std::vector<std::string> participants, std::size_t numRounds, std::uint64_t seed )
+: m_participants( std::move( participants ) ),
+m_numRounds( numRounds ),
+m_seed( seed ),
+m_hasResults( false )
+{
+    std::sort( m_participants.begin(), m_participants.end() );
+}
+
+bool Match::involves( const std::string& name ) const
+{
+    return std::find( m_participants.begin(), m_participants.end(), name ) != m_participants.end();
+}
+
+std::string Match::getKey( const std::map<std::string, std::string>& versions ) const
+{
+    std::string key;
+    for( auto&& name : m_participants )
+    {
+        auto it = versions.find( name );
+        key += name + "@" + ( it != versions.end() ? it->second : "" ) + " ";
+    }
+    return key + "rounds=" + std::to_string( m_numRounds ) + " seed=" + std::to_string( m_seed );
+}
+
+void Match::setResults( std::vector<BattleResults> results )
+{
+    m_results = std::move( results );
+    m_hasResults = true;
+}
+
+void Match::clearResults()
+{
+    m_results.clear();
+    m_hasResults = false;
+}
+
+std::uint64_t Match::deriveSeed( std::uint64_t tournamentSeed, const std::vector<std::string>& participants )
+{
+    // FNV-1a: unlike std::hash, it is the same on every platform and standard library
+    std::uint64_t hash = 14695981039346656037ull;
+    for( auto&& name : participants )
+    {
+        for( unsigned char c : name + '\n' )
+        {
+            hash = ( hash ^ c ) * 1099511628211ull;
+        }
+    }
+    return RandomStream::deriveSeed( tournamentSeed, hash );
+}
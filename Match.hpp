@@ -0,0 +1,65 @@
+#pragma once
+
+#include "BattleResults.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * One battle of a tournament between some contestants of the roster: a 1v1
+ * pairing or a melee group.
+ *
+ * Contestants are designated by the name their robots are given, which is
+ * also the name their results are reported under. The participants are kept
+ * sorted by name, so a match does not depend on the order of the roster.
+ */
+class Match
+{
+public:
+    Match( std::vector<std::string> participants, std::size_t numRounds, std::uint64_t seed );
+
+    const std::vector<std::string>& getParticipants() const { return m_participants; }
+    std::size_t getNumRounds() const { return m_numRounds; }
+    std::uint64_t getSeed() const { return m_seed; }
+
+    /**
+     * Returns whether the given contestant takes part in this match.
+     */
+    bool involves( const std::string& name ) const;
+
+    /**
+     * Returns a key identifying what this match would produce: the
+     * participants and their versions, the number of rounds and the seed.
+     * Results cached under the same key can be reused instead of running
+     * the match again.
+     *
+     * @param versions the version of each contestant, by name
+     * @return the key
+     */
+    std::string getKey( const std::map<std::string, std::string>& versions ) const;
+
+    bool hasResults() const { return m_hasResults; }
+    const std::vector<BattleResults>& getResults() const { return m_results; }
+    void setResults( std::vector<BattleResults> results );
+    void clearResults();
+
+    /**
+     * Returns a seed only depending on the tournament seed and on the names
+     * of the participants, so that a pairing replays the same battle from one
+     * tournament to the next.
+     *
+     * @param tournamentSeed the seed of the tournament
+     * @param participants the names of the participants
+     * @return the seed of their match
+     */
+    static std::uint64_t deriveSeed( std::uint64_t tournamentSeed, const std::vector<std::string>& participants );
+
+private:
+    std::vector<std::string> m_participants;
+    std::size_t m_numRounds;
+    std::uint64_t m_seed;
+    bool m_hasResults;
+    std::vector<BattleResults> m_results;
+};
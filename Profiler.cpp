@@ -0,0 +1,156 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    std::string formatDuration( double nanoseconds )
+    {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision( 1 );
+        if( nanoseconds < 1e3 )
+            out << nanoseconds << " ns";
+        else if( nanoseconds < 1e6 )
+            out << nanoseconds / 1e3 << " us";
+        else
+            out << nanoseconds / 1e6 << " ms";
+        return out.str();
+    }
+}
+
+Profiler::Profiler()
+: m_enabled( false )
+{
+    clear();
+}
+
+void Profiler::record( Phase phase, std::uint64_t nanoseconds )
+{
+    Histogram& histogram = m_phases[phase];
+
+    ++histogram.count;
+    histogram.total += nanoseconds;
+    histogram.max = std::max( histogram.max, nanoseconds );
+
+    std::size_t bucket = 0;
+    while( nanoseconds > 1 && bucket < BUCKET_COUNT - 1 )
+    {
+        nanoseconds >>= 1;
+        ++bucket;
+    }
+    ++histogram.buckets[bucket];
+}
+
+void Profiler::clear()
+{
+    for( auto&& histogram : m_phases )
+    {
+        histogram = Histogram();
+    }
+}
+
+Profiler& Profiler::operator+=( const Profiler& other )
+{
+    for( std::size_t phase = 0; phase < PHASE_COUNT; ++phase )
+    {
+        Histogram& histogram = m_phases[phase];
+        const Histogram& otherHistogram = other.m_phases[phase];
+
+        histogram.count += otherHistogram.count;
+        histogram.total += otherHistogram.total;
+        histogram.max = std::max( histogram.max, otherHistogram.max );
+        for( std::size_t i = 0; i < BUCKET_COUNT; ++i )
+        {
+            histogram.buckets[i] += otherHistogram.buckets[i];
+        }
+    }
+    return *this;
+}
+
+std::uint64_t Profiler::quantile( const Histogram& histogram, double q )
+{
+    std::uint64_t rank = q * histogram.count;
+    std::uint64_t seen = 0;
+    for( std::size_t i = 0; i < BUCKET_COUNT; ++i )
+    {
+        seen += histogram.buckets[i];
+        if( seen > rank )
+            return std::min( std::uint64_t( 2 ) << i, histogram.max );
+    }
+    return histogram.max;
+}
+
+void Profiler::report( std::ostream& out ) const
+{
+    const Histogram& tick = m_phases[TICK];
+
+    out << std::left << std::setw( 18 ) << "phase"
+        << std::right
+        << std::setw( 12 ) << "calls"
+        << std::setw( 12 ) << "total"
+        << std::setw( 8 ) << "share"
+        << std::setw( 12 ) << "mean"
+        << std::setw( 12 ) << "p50 <="
+        << std::setw( 12 ) << "p99 <="
+        << std::setw( 12 ) << "max"
+        << std::endl;
+
+    for( std::size_t phase = 0; phase < PHASE_COUNT; ++phase )
+    {
+        const Histogram& histogram = m_phases[phase];
+        if( histogram.count == 0 )
+            continue;
+
+        out << std::left << std::setw( 18 ) << getPhaseName( Phase( phase ) )
+            << std::right
+            << std::setw( 12 ) << histogram.count
+            << std::setw( 12 ) << formatDuration( histogram.total )
+            << std::setw( 7 ) << std::fixed << std::setprecision( 1 )
+            << ( tick.total ? 100. * histogram.total / tick.total : 0. ) << "%"
+            << std::setw( 12 ) << formatDuration( double( histogram.total ) / histogram.count )
+            << std::setw( 12 ) << formatDuration( quantile( histogram, .5 ) )
+            << std::setw( 12 ) << formatDuration( quantile( histogram, .99 ) )
+            << std::setw( 12 ) << formatDuration( histogram.max )
+            << std::endl;
+    }
+
+    for( std::size_t phase = 0; phase < PHASE_COUNT; ++phase )
+    {
+        const Histogram& histogram = m_phases[phase];
+        if( histogram.count == 0 )
+            continue;
+
+        out << std::endl << getPhaseName( Phase( phase ) ) << std::endl;
+
+        std::uint64_t highest = *std::max_element( std::begin( histogram.buckets ), std::end( histogram.buckets ) );
+        for( std::size_t i = 0; i < BUCKET_COUNT; ++i )
+        {
+            if( histogram.buckets[i] == 0 )
+                continue;
+
+            out << "  < " << std::left << std::setw( 10 ) << formatDuration( double( std::uint64_t( 2 ) << i ) )
+                << std::right << std::setw( 12 ) << histogram.buckets[i] << " "
+                << std::string( 40 * histogram.buckets[i] / highest, '#' )
+                << std::endl;
+        }
+    }
+}
+
+const char* Profiler::getPhaseName( Phase phase )
+{
+    switch( phase )
+    {
+    case TICK:             return "tick";
+    case BULLET_UPDATE:    return "bullet update";
+    case EVENT_PROCESSING: return "event processing";
+    case RUN:              return "run";
+    case MOVE:             return "performMove";
+    case COLLISION:        return "collisions";
+    case SCAN:             return "performScan";
+    default:               return "?";
+    }
+}
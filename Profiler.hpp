@@ -0,0 +1,111 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+/**
+ * Wall-clock time spent in each phase of a tick, as log2 histograms.
+ *
+ * Every World has its own profiler, disabled by default; when disabled a
+ * ScopedTimer costs a single test. Robot phases are timed per robot, the
+ * bullet update and the whole tick once per tick.
+ */
+class Profiler
+{
+public:
+    enum Phase
+    {
+        TICK,
+        BULLET_UPDATE,
+        EVENT_PROCESSING,
+        RUN,
+        MOVE,
+        COLLISION,
+        SCAN,
+        PHASE_COUNT
+    };
+
+    /**
+     * Adds the time between its construction and its destruction to a phase.
+     */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer( Profiler& profiler, Phase phase )
+        : m_pProfiler( profiler.isEnabled() ? &profiler : nullptr ),
+        m_phase( phase )
+        {
+            if( m_pProfiler )
+                m_start = Clock::now();
+        }
+
+        ~ScopedTimer()
+        {
+            if( m_pProfiler )
+                m_pProfiler->record( m_phase, std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - m_start ).count() );
+        }
+
+        ScopedTimer( const ScopedTimer& ) = delete;
+        ScopedTimer& operator=( const ScopedTimer& ) = delete;
+
+    private:
+        Profiler* m_pProfiler;
+        Phase m_phase;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    Profiler();
+
+    void setEnabled( bool enabled ) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * Adds one sample to a phase.
+     *
+     * @param phase the phase
+     * @param nanoseconds the time spent in it
+     */
+    void record( Phase phase, std::uint64_t nanoseconds );
+
+    /**
+     * Forgets every sample.
+     */
+    void clear();
+
+    /**
+     * Adds the samples of another profiler, e.g. to sum several battles.
+     */
+    Profiler& operator+=( const Profiler& other );
+
+    /**
+     * Writes a table of the time spent per phase, followed by the histogram
+     * of each phase.
+     */
+    void report( std::ostream& out ) const;
+
+    static const char* getPhaseName( Phase phase );
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    /** Bucket i counts the samples in [2^i, 2^(i+1)) ns. */
+    static constexpr std::size_t BUCKET_COUNT = 40;
+
+    struct Histogram
+    {
+        std::uint64_t count;
+        std::uint64_t total;
+        std::uint64_t max;
+        std::uint64_t buckets[BUCKET_COUNT];
+    };
+
+    /**
+     * Returns an upper bound of the given quantile of a histogram, in ns.
+     */
+    static std::uint64_t quantile( const Histogram& histogram, double q );
+
+    bool m_enabled;
+    Histogram m_phases[PHASE_COUNT];
+};
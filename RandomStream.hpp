@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * Counter-based random number generator.
+ *
+ * The n-th value of a stream is a pure function of (seed, stream, n): it is
+ * the SplitMix64 finalizer applied to a key derived from the seed and the
+ * stream index, plus the counter. Streams derived from the same seed are
+ * independent, so e.g. each round of a battle can draw from its own stream
+ * and be replayed in isolation.
+ *
+ * Satisfies UniformRandomBitGenerator, but nextInt() should be preferred to
+ * the std distributions, whose output differs between standard libraries.
+ */
+class RandomStream
+{
+public:
+    typedef std::uint64_t result_type;
+
+    explicit RandomStream( std::uint64_t seed = 0, std::uint64_t stream = 0 )
+    : m_key( deriveSeed( seed, stream ) ),
+    m_counter( 0 )
+    {
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        return mix( m_key + GOLDEN_GAMMA * ++m_counter );
+    }
+
+    /**
+     * Returns a uniformly distributed integer, without modulo bias.
+     *
+     * @param min the lowest value that can be returned
+     * @param max the highest value that can be returned
+     * @return a value in [min, max]
+     */
+    std::int64_t nextInt( std::int64_t min, std::int64_t max )
+    {
+        std::uint64_t range = std::uint64_t( max - min ) + 1;
+        if( range == 0 )
+        {
+            return std::int64_t( (*this)() );
+        }
+
+        // Lemire's nearly divisionless method
+        unsigned __int128 product = (unsigned __int128) (*this)() * range;
+        std::uint64_t low = std::uint64_t( product );
+        if( low < range )
+        {
+            std::uint64_t threshold = -range % range;
+            while( low < threshold )
+            {
+                product = (unsigned __int128) (*this)() * range;
+                low = std::uint64_t( product );
+            }
+        }
+        return min + std::int64_t( product >> 64 );
+    }
+
+    /**
+     * Returns a uniformly distributed double in [0, 1[.
+     */
+    double nextDouble()
+    {
+        return ( (*this)() >> 11 ) * 0x1.0p-53;
+    }
+
+    /**
+     * Derives the seed of an independent stream from a parent seed, e.g. the
+     * seed of the k-th battle of a farm from the seed of the whole run.
+     */
+    static std::uint64_t deriveSeed( std::uint64_t seed, std::uint64_t stream )
+    {
+        return mix( seed ^ mix( stream + GOLDEN_GAMMA ) );
+    }
+
+private:
+    static constexpr std::uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+    static std::uint64_t mix( std::uint64_t z )
+    {
+        z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+        z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+        return z ^ ( z >> 31 );
+    }
+
+    std::uint64_t m_key;
+    std::uint64_t m_counter;
+};
@@ -20,7 +20,7 @@
 
 Robot::Robot( World& world, const std::string& name, int x /*= 400*/, unsigned y /*= 400*/ )
  : m_world( world ),
- m_name( name ),
+ m_id( world.getContext().getRobotNames().add( name ) ),
  m_energy( 100 ),
  m_gunHeat( 0 ),
  m_velocity( 0 ),
@@ -29,6 +29,8 @@ Robot::Robot( World& world, const std::string& name, int x /*= 400*/, unsigned y
  m_isWinner( false ),
  m_inCollision( false ),
  m_isOverDriving( false ),
+ m_events( world.getEventArena() ),
+ m_dispatchedEvents( world.getEventArena() ),
  m_bulletColor( sf::Color::Red ),
  m_bodyColor( sf::Color::Black ),
  m_radarColor( sf::Color::Red ),
@@ -38,7 +40,11 @@ Robot::Robot( World& world, const std::string& name, int x /*= 400*/, unsigned y
  m_adjustRadarForRobotTurn( false ),
  m_state( RobotState::ACTIVE ),
  m_scanArc( x, y, Rules::RADAR_SCAN_RADIUS, 0, 0 ),
- m_statistics( this )
+m_worldIndex( 0 ),
+m_scanStamp( 0 ),
+m_hasScanned( false ),
+m_boxStamp( 0 ),
+ m_statistics( this, m_id, world.getContext().getScoreLedger() )
 {
     setPosition( x, y );
 }
@@ -47,10 +53,24 @@ void Robot::setPosition( int x, unsigned y )
 {
     m_bodyPosition.setPosition( x, y );
     updateBoundingBox();
+
+    // the broadphases of the world no longer know where the robot is
+    m_world.getRobotPairs().invalidate();
 }
 
 void Robot::reset()
 {
+    // a round must not depend on how the previous one ended
+    m_bodyPosition.setRotation( 0 );
+    m_heading = SinCos();
+    m_turretPosition.setRotation( 0 );
+    m_radarPosition.setRotation( 0 );
+    m_currentCommands = ExecCommands();
+    m_events.clear();
+    m_dispatchedEvents.clear();
+    m_scan = false;
+    m_inactiveTurnCount = 0;
+
     m_energy = 100;
     m_gunHeat = 0;
     m_velocity = 0;
@@ -61,13 +81,14 @@ void Robot::reset()
     m_isOverDriving = false;
     m_state = RobotState::ACTIVE;
     m_scanArc = Arc2D( m_bodyPosition.getPosition().x, m_bodyPosition.getPosition().y, Rules::RADAR_SCAN_RADIUS, 0, 0 );
+    m_hasScanned = false;
 
-    m_statistics.reset( m_world.getRobots().size() );
+    m_statistics.reset( m_world.getRobots().size(), m_world.getContext().getRobotNames().size() );
 }
 
 const std::string& Robot::getName() const
 {
-    return m_name;
+    return m_world.getContext().getRobotNames().getName( m_id );
 }
 
 void Robot::setBulletColor( sf::Color color )
@@ -235,6 +256,7 @@ float Robot::rotate( float angle )
     }
     
     m_bodyPosition.rotate( angle );
+    m_heading = SinCos( m_bodyPosition.getRotation() * Utils::toRadians );
 
     return angle;
 }
@@ -289,15 +311,20 @@ void Robot::setBack( double distance )
 }
 
 void Robot::setFire(double power)
+{
+    setFireBullet( power );
+}
+
+BulletHandle Robot::setFireBullet(double power)
 {
     if( std::isnan(power) )
     {
         std::cerr << "SYSTEM: You cannot call fire(NaN)" << std::endl;
-        return;
+        return BulletHandle();
     }
     
-    if( m_gunHeat > 0 || m_energy == 0)
-        return;
+    if( m_gunHeat > 0 || m_energy == 0 || m_world.getBullets().full() )
+        return BulletHandle();
 
     double firePower = std::min( m_energy,
             std::min( std::max( power, Rules::MIN_BULLET_POWER), Rules::MAX_BULLET_POWER ) );
@@ -306,14 +333,7 @@ void Robot::setFire(double power)
 
     m_gunHeat += Rules::getGunHeat(firePower);
 
-    Bullet newBullet( this );
-
-    newBullet.setPower(firePower);
-    newBullet.setHeading(getTurretAngle());
-    newBullet.setX(getX());
-    newBullet.setY(getY());
-
-    m_world.addBullet( newBullet );
+    return m_world.addBullet( this, firePower, getTurretAngle(), getX(), getY() );
 }
 
 void Robot::drainEnergy()
@@ -421,14 +441,14 @@ void Robot::updateMovement()
     m_currentCommands.setDistanceRemaining(distance - m_velocity);
 
     if (m_velocity != 0) {
-        double x = m_velocity * std::sin(m_bodyPosition.getRotation() * Utils::toRadians);
-        double y = m_velocity * std::cos(m_bodyPosition.getRotation() * Utils::toRadians);
+        double x = m_velocity * m_heading.sin();
+        double y = m_velocity * m_heading.cos();
         m_bodyPosition.move( x, y );
         updateBoundingBox();
     }
 }
 
-std::string Robot::getNameForEvent( Robot* otherRobot )
+const std::string& Robot::getNameForEvent( Robot* otherRobot )
 {/*
     if( Rules::getHideEnemyNames() && !isTeamMate( otherRobot ) ) {
         return otherRobot->getAnnonymousName();
@@ -436,7 +456,7 @@ std::string Robot::getNameForEvent( Robot* otherRobot )
     return otherRobot->getName();
 }		
 
-bool Robot::isCollidingRobot( std::list<Robot*> robots )
+bool Robot::isCollidingRobot( Span<Robot*> robots )
 {
     for( Robot* otherRobot : robots )
     {
@@ -450,12 +470,13 @@ bool Robot::isCollidingRobot( std::list<Robot*> robots )
     return false;
 }
 
-void Robot::checkRobotCollision( std::list<Robot*> robots )
+void Robot::checkRobotCollision( Span<Robot*> robots, Span<const std::uint32_t> candidates )
 {
     m_inCollision = false;
 
-    for( Robot* otherRobot : robots )
+    for( std::uint32_t index : candidates )
     {
+        Robot* otherRobot = robots[index];
         if( !( otherRobot == nullptr || otherRobot == this || otherRobot->isDead() )
                 && m_boundingBox.intersects( otherRobot->m_boundingBox ) )
         {
@@ -463,8 +484,8 @@ void Robot::checkRobotCollision( std::list<Robot*> robots )
             double angle = std::atan2( otherRobot->m_bodyPosition.getPosition().x - m_bodyPosition.getPosition().x,
                                        otherRobot->m_bodyPosition.getPosition().y - m_bodyPosition.getPosition().y);
 
-            double movedx = m_velocity * std::sin( getBodyHeading() );
-            double movedy = m_velocity * std::cos( getBodyHeading() );
+            double movedx = m_velocity * m_heading.sin();
+            double movedy = m_velocity * m_heading.cos();
 
             bool atFault;
             double bearing = Utils::normalRelativeAngle( angle - getBodyHeading() );
@@ -479,7 +500,7 @@ void Robot::checkRobotCollision( std::list<Robot*> robots )
                 m_currentCommands.setDistanceRemaining( 0 );
                 m_bodyPosition.move( -movedx, -movedy );
 
-                m_statistics.scoreRammingDamage( otherRobot->getName() );
+                m_statistics.scoreRammingDamage( otherRobot->getRobotId() );
 
                 updateEnergy( -Rules::ROBOT_HIT_DAMAGE );
                 otherRobot->updateEnergy( -Rules::ROBOT_HIT_DAMAGE );
@@ -489,7 +510,7 @@ void Robot::checkRobotCollision( std::list<Robot*> robots )
                     if( otherRobot->isAlive() )
                     {
                         otherRobot->kill();
-                        double bonus = m_statistics.scoreRammingKill( otherRobot->getName() );
+                        double bonus = m_statistics.scoreRammingKill( otherRobot->getRobotId() );
 
                         if( bonus > 0 )
                         {
@@ -499,15 +520,13 @@ void Robot::checkRobotCollision( std::list<Robot*> robots )
                         }
                     }
                 }
-                addEvent(
-                        std::make_unique<HitRobotEvent>( getNameForEvent( otherRobot ),
+                addEvent<HitRobotEvent>( m_world.getContext().getRobotNames(), otherRobot->getRobotId(),
                         Utils::normalRelativeAngle( angle - getBodyHeading() ),
-                        otherRobot->m_energy, atFault ) );
+                        otherRobot->m_energy, atFault );
 
-                otherRobot->addEvent(
-                        std::make_unique<HitRobotEvent>( getNameForEvent(this),
+                otherRobot->addEvent<HitRobotEvent>( m_world.getContext().getRobotNames(), getRobotId(),
                         Utils::normalRelativeAngle( Utils::PI + angle - otherRobot->getBodyHeading() ),
-                        m_energy, false ) );
+                        m_energy, false );
             }
         }
     }
@@ -558,12 +577,12 @@ void Robot::checkWallCollision()
 
     if (hitWall)
     {
-        addEvent( std::make_unique<HitWallEvent>( angle ) );
+        addEvent<HitWallEvent>( angle );
 
         // only fix both x and y values if hitting wall at an angle
         if( ( int(getBodyHeading()) % int( Utils::PI / 2 ) ) != 0)
         {
-            double tanHeading = tan( getBodyHeading() );
+            double tanHeading = m_heading.tan();
 
             // if it hits bottom or top wall
             if (adjustX == 0)
@@ -671,57 +690,72 @@ double Robot::maxDecel(double speed)
 
 void Robot::updateBoundingBox()
 {
-    m_boundingBox = sf::FloatRect( getX() - HALF_WIDTH_OFFSET, getY() - HALF_HEIGHT_OFFSET, WIDTH, HEIGHT);
+    sf::FloatRect box( getX() - HALF_WIDTH_OFFSET, getY() - HALF_HEIGHT_OFFSET, WIDTH, HEIGHT );
+    if( box != m_boundingBox )
+    {
+        m_boundingBox = box;
+        m_boxStamp = m_world.nextBoxStamp();
+    }
 }
 
 void Robot::tick()
 {
-    processEvents();
-    
-    run();
+    Profiler& profiler = m_world.getContext().getProfiler();
+
+    {
+        Profiler::ScopedTimer timer( profiler, Profiler::EVENT_PROCESSING );
+        processEvents();
+    }
+
+    {
+        Profiler::ScopedTimer timer( profiler, Profiler::RUN );
+        run();
+    }
 
     performMove();
 
-    performScan();
+    {
+        Profiler::ScopedTimer timer( profiler, Profiler::SCAN );
+        performScan();
+    }
 
 	m_inactiveTurnCount++;
 }
 
 void Robot::processEvents()
 {
-    for( auto& event : m_events )
+    m_dispatchedEvents.swap( m_events );
+    m_dispatchedEvents.sort();
+
+    for( EventQueue::Entry* event : m_dispatchedEvents )
     {
-        if( auto ptr = dynamic_cast<BulletHitBulletEvent*>( event.get() ) )
-        {
-            onBulletHitBullet( ptr );
-        }
-        if( auto ptr = dynamic_cast<DeathEvent*>( event.get() ) )
-        {
-            onDeath( ptr );
-        }
-        if( auto ptr = dynamic_cast<HitRobotEvent*>( event.get() ) )
-        {
-            onHitRobot( ptr );
-        }
-        if( auto ptr = dynamic_cast<HitWallEvent*>( event.get() ) )
-        {
-            onHitWall( ptr );
-        }
-        if( auto ptr = dynamic_cast<ScannedRobotEvent*>( event.get() ) )
-        {
-            onScannedRobot( ptr );
-        }
-        if( auto ptr = dynamic_cast<RoundEndedEvent*>( event.get() ) )
-        {
-            onRoundEnded( ptr );
-        }
-        if( auto ptr = dynamic_cast<BattleEndedEvent*>( event.get() ) )
+        switch( event->getType() )
         {
-            onBattleEnded( ptr );
+            case EventQueue::BULLET_HIT_BULLET:
+                onBulletHitBullet( &event->get<BulletHitBulletEvent>() );
+                break;
+            case EventQueue::DEATH:
+                onDeath( &event->get<DeathEvent>() );
+                break;
+            case EventQueue::HIT_ROBOT:
+                onHitRobot( &event->get<HitRobotEvent>() );
+                break;
+            case EventQueue::HIT_WALL:
+                onHitWall( &event->get<HitWallEvent>() );
+                break;
+            case EventQueue::SCANNED_ROBOT:
+                onScannedRobot( &event->get<ScannedRobotEvent>() );
+                break;
+            case EventQueue::ROUND_ENDED:
+                onRoundEnded( &event->get<RoundEndedEvent>() );
+                break;
+            case EventQueue::BATTLE_ENDED:
+                onBattleEnded( &event->get<BattleEndedEvent>() );
+                break;
         }
     }
 
-    m_events.clear();
+    m_dispatchedEvents.clear();
 }
 
 void Robot::performMove()
@@ -740,21 +774,33 @@ void Robot::performMove()
     double lastX = getX();
     double lastY = getY();
 
-    if( !m_inCollision )
-        updateHeading();
+    Profiler& profiler = m_world.getContext().getProfiler();
 
-    updateGunHeading();
-    updateRadarHeading();
-    updateMovement();
+    {
+        Profiler::ScopedTimer timer( profiler, Profiler::MOVE );
+
+        if( !m_inCollision )
+            updateHeading();
+
+        updateGunHeading();
+        updateRadarHeading();
+        updateMovement();
+    }
 
     // At this point, robot has turned then moved.
     // We could be touching a wall or another bot...
 
-    // First and foremost, we can never go through a wall:
-    checkWallCollision();
+    {
+        Profiler::ScopedTimer timer( profiler, Profiler::COLLISION );
+
+        // First and foremost, we can never go through a wall:
+        checkWallCollision();
 
-    // Now check for robot collision
-    checkRobotCollision( m_world.getRobots() );
+        // Now check for robot collision, against the robots that were close enough at the start of the turn
+        SweepAndPrune& robotPairs = m_world.getRobotPairs();
+        robotPairs.track( m_worldIndex, m_boundingBox );
+        checkRobotCollision( m_world.getRobots(), robotPairs.getCandidates( m_worldIndex ) );
+    }
 
     // Scan false means robot did not call scan() manually.
     // But if we're moving, scan
@@ -800,12 +846,7 @@ void Robot::performScan()
     m_lastRadarHeading = -1;
 }
 
-void Robot::addEvent( std::unique_ptr<Event> evt )
-{
-    m_events.push_back( std::move( evt ) );
-}
-
-void Robot::scan( double lastRadarHeading, std::list<Robot*> robots )
+void Robot::scan( double lastRadarHeading, Span<Robot*> robots )
 {
     double startAngle = lastRadarHeading;
     double scanRadians = getRadarHeading() - startAngle;
@@ -824,32 +865,75 @@ void Robot::scan( double lastRadarHeading, std::list<Robot*> robots )
 
     startAngle = Utils::normalAbsoluteAngle( startAngle );
 
-    m_scanArc = Arc2D( getX(), getY(), Rules::RADAR_SCAN_RADIUS, startAngle, scanRadians );
+    Arc2D scanArc( getX(), getY(), Rules::RADAR_SCAN_RADIUS, startAngle, scanRadians );
+    bool sameArc = m_hasScanned && scanArc == m_scanArc;
+    m_scanArc = scanArc;
 
-    for( Robot* otherRobot : robots)
+    // the robots found, in the order of the world
+    m_scanTargets.clear();
+
+    if( sameArc )
     {
-        if ( !(otherRobot == nullptr || otherRobot == this || otherRobot->isDead())
-                && intersects( m_scanArc, otherRobot->m_boundingBox ) )
+        // only the robots whose box changed since the last scan can have come in or out of the arc
+        std::size_t previous = 0;
+        for( Robot* otherRobot : robots )
         {
-            double dx = otherRobot->getX() - getX();
-            double dy = otherRobot->getY() - getY();
-            double angle = atan2(dx, dy);
-            double dist = std::hypot(dx, dy);
-
-            addEvent(
-                    std::make_unique<ScannedRobotEvent>( getNameForEvent( otherRobot ),
-                    otherRobot->m_energy,
-                    Utils::normalRelativeAngle( angle - getBodyHeading() ), dist, otherRobot->getBodyHeading(),
-                    otherRobot->getVelocity()) );
+            // the robots found last time that died since may have left the world
+            while( previous < m_scanned.size() && m_scanned[previous]->isDead() )
+                ++previous;
+            bool wasFound = previous < m_scanned.size() && m_scanned[previous] == otherRobot;
+            if( wasFound )
+                ++previous;
+
+            if( otherRobot == nullptr || otherRobot == this || otherRobot->isDead() )
+                continue;
+
+            if( otherRobot->m_boxStamp > m_scanStamp ? m_scanArc.intersects( otherRobot->m_boundingBox ) : wasFound )
+                m_scanTargets.push_back( otherRobot );
         }
     }
-}
+    else
+    {
+        // test the boxes of the other robots near the arc at once
+        m_scanBoxes.clear();
+        for( std::uint32_t index : m_world.findScanTargets( m_scanArc ) )
+        {
+            Robot* otherRobot = robots[index];
+            if( !( otherRobot == nullptr || otherRobot == this || otherRobot->isDead() ) )
+            {
+                m_scanTargets.push_back( otherRobot );
+                m_scanBoxes.push_back( otherRobot->m_boundingBox );
+            }
+        }
+        m_scanHits.resize( m_scanBoxes.size() );
+        m_scanArc.intersects( m_scanBoxes, m_scanHits );
 
-bool Robot::intersects( Arc2D arc, sf::FloatRect rect )
-{
-    return /*(rect.intersectsLine(arc.getCenterX(), arc.getCenterY(), arc.getStartPoint().getX(),
-            arc.getStartPoint().getY()))
-            || */ arc.intersects( rect );
+        std::size_t found = 0;
+        for( std::size_t i = 0; i < m_scanTargets.size(); ++i )
+        {
+            if( m_scanHits[i] )
+                m_scanTargets[found++] = m_scanTargets[i];
+        }
+        m_scanTargets.resize( found );
+    }
+
+    m_scanned.swap( m_scanTargets );
+    m_scanStamp = m_world.getBoxStamp();
+    m_hasScanned = true;
+
+    // the events tell where the robots are now
+    for( Robot* otherRobot : m_scanned )
+    {
+        double dx = otherRobot->getX() - getX();
+        double dy = otherRobot->getY() - getY();
+        double angle = atan2(dx, dy);
+        double dist = std::hypot(dx, dy);
+
+        addEvent<ScannedRobotEvent>( m_world.getContext().getRobotNames(), otherRobot->getRobotId(),
+                otherRobot->m_energy,
+                Utils::normalRelativeAngle( angle - getBodyHeading() ), dist, otherRobot->getBodyHeading(),
+                otherRobot->getVelocity() );
+    }
 }
 
 void Robot::zap( double zapAmount )
@@ -874,19 +958,12 @@ void Robot::kill()
     //battle.resetInactiveTurnCount(10.0);
     if( isAlive() )
     {
-        addEvent( std::make_unique<DeathEvent>() );
+        addEvent<DeathEvent>();
 
         //battle.registerDeathRobot(this);
 
         // 'fake' bullet for explosion on self
-        Bullet fakeBullet( this );
-
-        fakeBullet.setPower( 1 );
-        fakeBullet.setHeading(0);
-        fakeBullet.setX(getX());
-        fakeBullet.setY(getY());
-
-        m_world.addBullet( fakeBullet );
+        m_world.addBullet( this, 1, 0, getX(), getY() );
     }
     updateEnergy(-m_energy);
 
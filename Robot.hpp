@@ -1,16 +1,20 @@
 #pragma once
 
 #include "Rules.hpp"
-#include "Event.hpp"
+#include "EventQueue.hpp"
 #include "ExecCommands.hpp"
+#include "BulletHandle.hpp"
 #include "Arc2D.hpp"
 #include "RobotStatistics.hpp"
+#include "SinCos.hpp"
+#include "Span.hpp"
 
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/Graphics/Color.hpp>
 
+#include <cstdint>
 #include <memory>
-#include <list>
+#include <vector>
 #include <algorithm>
 #include <cmath>
 
@@ -56,12 +60,16 @@ public:
 			HALF_HEIGHT_OFFSET = HEIGHT / 2;
 
     Robot( World& world, const std::string& name, int x = 400, unsigned y = 300 );
+    virtual ~Robot() {}
 
     void setPosition( int x, unsigned y );
     void reset();
 
     const std::string& getName() const;
 
+    /** Returns the id of the robot within its battle. */
+    RobotId getRobotId() const { return m_id; }
+
     void setBulletColor( sf::Color color );
     void setBodyColor( sf::Color color );
     void setRadarColor( sf::Color color );
@@ -85,6 +93,10 @@ public:
 
     World& getWorld() { return m_world; }
 
+    /** Position of the robot in World::getRobots(), kept up to date by the World. */
+    std::uint32_t getWorldIndex() const { return m_worldIndex; }
+    void setWorldIndex( std::uint32_t index ) { m_worldIndex = index; }
+
     RobotState::EState getState()
     {
         return m_state;
@@ -151,6 +163,14 @@ public:
 
     void setFire( double power );
 
+    /**
+     * Fires a bullet, like setFire().
+     *
+     * @return the handle of the bullet in the world, or a null handle if no
+     *         bullet was fired (gun still hot, or no room for more bullets)
+     */
+    BulletHandle setFireBullet( double power );
+
     void drainEnergy();
     void setEnergy( double newEnergy, bool resetInactiveTurnCount );
 
@@ -161,10 +181,10 @@ public:
     void updateGunHeading();
     void updateMovement();
 
-    std::string getNameForEvent( Robot* otherRobot );
-    bool isCollidingRobot( std::list<Robot*> robots );
+    const std::string& getNameForEvent( Robot* otherRobot );
+    bool isCollidingRobot( Span<Robot*> robots );
 
-    void checkRobotCollision( std::list<Robot*> robots );
+    void checkRobotCollision( Span<Robot*> robots, Span<const std::uint32_t> candidates );
     void checkWallCollision();
 
     double getDistanceTraveledUntilStop(double velocity);
@@ -179,7 +199,16 @@ public:
     void performMove();
     void performScan();
 
-    void addEvent( std::unique_ptr<Event> evt );
+    template<typename T, typename... Args>
+    void addEvent( Args&&... args )
+    {
+        m_events.add<T>( std::forward<Args>( args )... );
+    }
+
+    /**
+     * Keeps the pending events alive over the next flip of the event arena.
+     */
+    void retainEvents() { m_events.retain(); }
 
     virtual void run() = 0;
     virtual void onBulletHitBullet( BulletHitBulletEvent* e ) {};
@@ -191,7 +220,7 @@ public:
 	virtual void onRoundEnded( RoundEndedEvent* e ) {};
 	virtual void onBattleEnded( BattleEndedEvent* e ) {};
 
-    RobotStatistics getRobotStatistics() { return m_statistics; }
+    RobotStatistics& getRobotStatistics() { return m_statistics; }
 
 protected:
 
@@ -199,15 +228,14 @@ protected:
     float rotateTurret( float angle );
     float rotateRadar( float angle );
 
-    void scan( double lastRadarHeading, std::list<Robot*> robots );
-    bool intersects( Arc2D arc, sf::FloatRect rect );
+    void scan( double lastRadarHeading, Span<Robot*> robots );
 
     void zap( double zapAmount );
 
 private:
     World& m_world;
 
-    std::string m_name;
+    RobotId m_id;
 
     ExecCommands m_currentCommands;
 
@@ -215,6 +243,9 @@ private:
     sf::Transformable m_turretPosition;
     sf::Transformable m_radarPosition;
 
+    /** The sine and cosine of the body heading, updated when the body turns. */
+    SinCos m_heading;
+
     sf::FloatRect m_boundingBox;
 
     double m_lastHeading;
@@ -234,7 +265,8 @@ private:
 	bool m_inCollision;
 	bool m_isOverDriving;
 
-    std::list<std::unique_ptr<Event>> m_events;
+    EventQueue m_events;
+    EventQueue m_dispatchedEvents; // the events being delivered, so that handlers can add new ones
 
     sf::Color m_bulletColor;
     sf::Color m_bodyColor;
@@ -247,7 +279,21 @@ private:
 
     RobotState::EState m_state;
     Arc2D m_scanArc;
+
+    // scratch of scan(), kept to reuse their storage
+    std::vector<Robot*> m_scanTargets;
+    std::vector<sf::FloatRect> m_scanBoxes;
+    std::vector<std::uint8_t> m_scanHits;
     std::size_t m_inactiveTurnCount;
+    std::uint32_t m_worldIndex;
+
+    /** Robots found by the last scan, in the order of the world, and the box stamp of the world then. */
+    std::vector<Robot*> m_scanned;
+    std::uint64_t m_scanStamp;
+    bool m_hasScanned;
+
+    /** World::nextBoxStamp() of the last change of m_boundingBox. */
+    std::uint64_t m_boxStamp;
 
     RobotStatistics m_statistics;
 };
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "RobotGrid.hpp"
+
+#include "Robot.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+RobotGrid::RobotGrid()
+: m_columns( 0 ),
+m_rows( 0 )
+{
+}
+
+int RobotGrid::cellX( double x ) const
+{
+    return std::min( std::max( int( std::floor( x / CELL_SIZE ) ), 0 ), m_columns - 1 );
+}
+
+int RobotGrid::cellY( double y ) const
+{
+    return std::min( std::max( int( std::floor( y / CELL_SIZE ) ), 0 ), m_rows - 1 );
+}
+
+void RobotGrid::build( Span<Robot*> robots, double width, double height )
+{
+    m_columns = std::max( 1, int( std::ceil( width / CELL_SIZE ) ) );
+    m_rows = std::max( 1, int( std::ceil( height / CELL_SIZE ) ) );
+
+    // count the robots of each cell, shifted by one...
+    m_cellStart.assign( m_columns * m_rows + 1, 0 );
+    for( Robot* pRobot : robots )
+    {
+        sf::FloatRect box = pRobot->getBoundingBox();
+        for( int y = cellY( box.top ); y <= cellY( double( box.top ) + box.height ); ++y )
+        {
+            for( int x = cellX( box.left ); x <= cellX( double( box.left ) + box.width ); ++x )
+            {
+                ++m_cellStart[y * m_columns + x + 1];
+            }
+        }
+    }
+
+    // ...so that the prefix sum gives where each cell starts
+    for( std::size_t c = 1; c < m_cellStart.size(); ++c )
+    {
+        m_cellStart[c] += m_cellStart[c - 1];
+    }
+
+    m_items.resize( m_cellStart.back() );
+
+    // fill, using the start of the next cell as the cursor of each cell, then shift back
+    for( std::uint32_t i = 0; i < robots.size(); ++i )
+    {
+        sf::FloatRect box = robots[i]->getBoundingBox();
+        for( int y = cellY( box.top ); y <= cellY( double( box.top ) + box.height ); ++y )
+        {
+            for( int x = cellX( box.left ); x <= cellX( double( box.left ) + box.width ); ++x )
+            {
+                m_items[m_cellStart[y * m_columns + x]++] = i;
+            }
+        }
+    }
+    for( std::size_t c = m_cellStart.size() - 1; c > 0; --c )
+    {
+        m_cellStart[c] = m_cellStart[c - 1];
+    }
+    m_cellStart[0] = 0;
+}
+
+Span<const std::uint32_t> RobotGrid::query( double minX, double minY, double maxX, double maxY )
+{
+    m_found.clear();
+
+    if( m_columns == 0 )
+    {
+        return m_found;
+    }
+
+    for( int y = cellY( minY ); y <= cellY( maxY ); ++y )
+    {
+        for( int x = cellX( minX ); x <= cellX( maxX ); ++x )
+        {
+            addCell( x, y );
+        }
+    }
+
+    std::sort( m_found.begin(), m_found.end() );
+    m_found.erase( std::unique( m_found.begin(), m_found.end() ), m_found.end() );
+
+    return m_found;
+}
+
+Span<const std::uint32_t> RobotGrid::query( const Arc2D& arc, double margin )
+{
+    m_found.clear();
+
+    if( m_columns == 0 )
+    {
+        return m_found;
+    }
+
+    const Arc2D::Point corners[3] = { arc.origin(), arc.start(), arc.end() };
+    double minY = std::min( { corners[0].y(), corners[1].y(), corners[2].y() } );
+    double maxY = std::max( { corners[0].y(), corners[1].y(), corners[2].y() } );
+
+    // slack for the rounding of the clipping below
+    margin += 1e-6;
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    for( int y = cellY( minY - margin ); y <= cellY( maxY + margin ); ++y )
+    {
+        // the band of this row, the outer rows holding everything beyond
+        // them, grown by the margin
+        double bandMin = y == 0 ? -infinity : y * CELL_SIZE - margin;
+        double bandMax = y == m_rows - 1 ? infinity : ( y + 1 ) * CELL_SIZE + margin;
+
+        // the part of the arc in the band is bounded by where its edges enter and leave the band
+        double minX = infinity;
+        double maxX = -infinity;
+        for( int i = 0; i < 3; ++i )
+        {
+            const Arc2D::Point& a = corners[i];
+            const Arc2D::Point& b = corners[( i + 1 ) % 3];
+
+            double low = 0;
+            double high = 1;
+            double dy = b.y() - a.y();
+            if( dy == 0 )
+            {
+                if( a.y() < bandMin || a.y() > bandMax )
+                    continue;
+            }
+            else
+            {
+                double t1 = ( bandMin - a.y() ) / dy;
+                double t2 = ( bandMax - a.y() ) / dy;
+                low = std::max( low, std::min( t1, t2 ) );
+                high = std::min( high, std::max( t1, t2 ) );
+                if( low > high )
+                    continue;
+            }
+
+            double dx = b.x() - a.x();
+            minX = std::min( { minX, a.x() + low * dx, a.x() + high * dx } );
+            maxX = std::max( { maxX, a.x() + low * dx, a.x() + high * dx } );
+        }
+
+        if( minX > maxX )
+            continue;
+
+        for( int x = cellX( minX - margin ); x <= cellX( maxX + margin ); ++x )
+        {
+            addCell( x, y );
+        }
+    }
+
+    std::sort( m_found.begin(), m_found.end() );
+    m_found.erase( std::unique( m_found.begin(), m_found.end() ), m_found.end() );
+
+    return m_found;
+}
+
+void RobotGrid::clear()
+{
+    m_columns = 0;
+    m_rows = 0;
+}
+
+void RobotGrid::addCell( int x, int y )
+{
+    int cell = y * m_columns + x;
+    m_found.insert( m_found.end(), m_items.begin() + m_cellStart[cell], m_items.begin() + m_cellStart[cell + 1] );
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Arc2D.hpp"
+#include "Span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Robot;
+
+/**
+ * Uniform grid over the battlefield, listing in each cell the robots whose
+ * bounding box overlaps it, so that a query only visits the robots near an
+ * area instead of all of them.
+ *
+ * Robots are designated by their index in the span the grid was built from.
+ * The cells are stored back to back in one array (counting sort), so that
+ * rebuilding the grid does not allocate once it has reached its size.
+ */
+class RobotGrid
+{
+public:
+    /** Side of a cell: a robot overlaps at most 4 cells. */
+    static constexpr double CELL_SIZE = 64;
+
+    RobotGrid();
+
+    /**
+     * Lists the bounding boxes of the given robots, dead or alive, in the
+     * cells of a width x height battlefield.
+     */
+    void build( Span<Robot*> robots, double width, double height );
+
+    /**
+     * Returns the indices of the robots whose cells overlap the given area
+     * (bounds included),
+     * without duplicates, in increasing order. The robots found may not
+     * overlap the area themselves, but all the robots overlapping it are found.
+     *
+     * The span is valid until the next query.
+     */
+    Span<const std::uint32_t> query( double minX, double minY, double maxX, double maxY );
+
+    /**
+     * Returns the indices of the robots whose cells overlap a radar arc grown
+     * by a margin on each side, without duplicates, in increasing order. Only
+     * the cells the arc goes through are visited, row by row.
+     *
+     * A robot that moved by up to the margin since the grid was built, and
+     * overlaps the arc now, is found.
+     *
+     * The span is valid until the next query.
+     */
+    Span<const std::uint32_t> query( const Arc2D& arc, double margin );
+
+    /**
+     * Forgets the robots, until the next build().
+     */
+    void clear();
+
+    bool isBuilt() const { return m_columns != 0; }
+
+private:
+    int cellX( double x ) const;
+    int cellY( double y ) const;
+
+    void addCell( int x, int y );
+
+    int m_columns;
+    int m_rows;
+
+    /** m_cellStart[c] to m_cellStart[c + 1] are the items of cell c. */
+    std::vector<std::uint32_t> m_cellStart;
+    std::vector<std::uint32_t> m_items;
+
+    std::vector<std::uint32_t> m_found;
+};
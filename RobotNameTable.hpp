@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/** Identifies a robot within a battle: 0 to the number of robots - 1. */
+typedef std::uint32_t RobotId;
+
+/**
+ * The robots of a battle, by id, and their names. Events and statistics
+ * designate robots by id, and the names are only looked up when a robot
+ * asks for them.
+ *
+ * Each distinct name is stored once, and stays at the same address for the
+ * life of the table.
+ */
+class RobotNameTable
+{
+public:
+    /**
+     * Gives an id to a new robot.
+     *
+     * @param name the name of the robot
+     * @return its id, the number of robots added before it
+     */
+    RobotId add( const std::string& name )
+    {
+        m_names.push_back( &*m_interned.insert( name ).first );
+        return RobotId( m_names.size() - 1 );
+    }
+
+    const std::string& getName( RobotId id ) const
+    {
+        return *m_names[id];
+    }
+
+    std::size_t size() const
+    {
+        return m_names.size();
+    }
+
+private:
+    std::unordered_set<std::string> m_interned;
+    std::vector<const std::string*> m_names;
+};
@@ -2,9 +2,12 @@
 
 #include "Robot.hpp"
 
-RobotStatistics::RobotStatistics( Robot* pRobot )
+RobotStatistics::RobotStatistics( Robot* pRobot, RobotId id, ScoreLedger& ledger )
+: m_pRobot( pRobot ),
+m_id( id ),
+m_pLedger( &ledger )
 {
-    m_pRobot = pRobot;
+    m_pLedger->fit( id + 1 );
 }
 
 void RobotStatistics::scoreRobotDeath(int enemiesRemaining)
@@ -12,23 +15,23 @@ void RobotStatistics::scoreRobotDeath(int enemiesRemaining)
     switch (enemiesRemaining) {
     case 0:
         if (!m_pRobot->isWinner()) {
-            totalFirsts++;
+            m_pLedger->m_totalFirsts[m_id]++;
         }
         break;
 
     case 1:
-        totalSeconds++;
+        m_pLedger->m_totalSeconds[m_id]++;
         break;
 
     case 2:
-        totalThirds++;
+        m_pLedger->m_totalThirds[m_id]++;
         break;
     }
 }
 
 BattleResults RobotStatistics::getFinalResults()
 {
-    return BattleResults( m_pRobot->getName(), rank, totalScore, totalSurvivalScore, totalLastSurvivorBonus,
-            totalBulletDamageScore, totalBulletKillBonus, totalRammingDamageScore, totalRammingKillBonus, totalFirsts,
-            totalSeconds, totalThirds );
-}
\ No newline at end of file
+    return BattleResults( m_pRobot->getName(), m_pLedger->m_rank[m_id], getTotalScore(), getTotalSurvivalScore(),
+            getTotalLastSurvivorBonus(), getTotalBulletDamageScore(), getTotalBulletKillBonus(), getTotalRammingDamageScore(),
+            getTotalRammingKillBonus(), getTotalFirsts(), getTotalSeconds(), getTotalThirds() );
+}
@@ -4,151 +4,155 @@ class Robot;
 
 #include "BattleResults.hpp"
 #include "Rules.hpp"
+#include "ScoreLedger.hpp"
 
-#include <map>
-#include <string>
-
+/**
+ * The scores of a robot: its row of the ScoreLedger of its battle, which it
+ * updates in place.
+ */
 class RobotStatistics
 {
 public:
-    RobotStatistics( Robot* pRobot );
+    RobotStatistics( Robot* pRobot, RobotId id, ScoreLedger& ledger );
 
-	void reset( int numberOfRobots ) {
+	void reset( int numberOfRobots, std::size_t numberOfIds ) {
 		resetScores();
+		m_pLedger->m_damage.fit( numberOfIds );
 
-        m_numberOfRobots = numberOfRobots;
+		m_pLedger->m_numberOfRobots = numberOfRobots;
 
-		isActive = true;
-		m_bIsInRound = true;
+		m_pLedger->m_isActive[m_id] = true;
+		m_pLedger->m_isInRound[m_id] = true;
 	}
 
 	void generateTotals() {
-		totalSurvivalScore += survivalScore;
-		totalLastSurvivorBonus += lastSurvivorBonus;
-		totalBulletDamageScore += bulletDamageScore;
-		totalBulletKillBonus += bulletKillBonus;
-		totalRammingDamageScore += rammingDamageScore;
-		totalRammingKillBonus += rammingKillBonus;
+		ScoreLedger& l = *m_pLedger;
+		l.m_totalSurvivalScore[m_id] += l.m_survivalScore[m_id];
+		l.m_totalLastSurvivorBonus[m_id] += l.m_lastSurvivorBonus[m_id];
+		l.m_totalBulletDamageScore[m_id] += l.m_bulletDamageScore[m_id];
+		l.m_totalBulletKillBonus[m_id] += l.m_bulletKillBonus[m_id];
+		l.m_totalRammingDamageScore[m_id] += l.m_rammingDamageScore[m_id];
+		l.m_totalRammingKillBonus[m_id] += l.m_rammingKillBonus[m_id];
 
-		totalScore = totalBulletDamageScore + totalRammingDamageScore + totalSurvivalScore + totalRammingKillBonus
-				   + totalBulletKillBonus + totalLastSurvivorBonus;
+		l.m_totalScore[m_id] = l.m_totalBulletDamageScore[m_id] + l.m_totalRammingDamageScore[m_id] + l.m_totalSurvivalScore[m_id]
+				   + l.m_totalRammingKillBonus[m_id] + l.m_totalBulletKillBonus[m_id] + l.m_totalLastSurvivorBonus[m_id];
 
-		m_bIsInRound = false;
+		l.m_isInRound[m_id] = false;
 	}
 
-	double getTotalScore() {
-		return totalScore;
+	double getTotalScore() const {
+		return m_pLedger->m_totalScore[m_id];
 	}
 
-	double getTotalSurvivalScore() {
-		return totalSurvivalScore;
+	double getTotalSurvivalScore() const {
+		return m_pLedger->m_totalSurvivalScore[m_id];
 	}
 
-	double getTotalLastSurvivorBonus() {
-		return totalLastSurvivorBonus;
+	double getTotalLastSurvivorBonus() const {
+		return m_pLedger->m_totalLastSurvivorBonus[m_id];
 	}
 
-	double getTotalBulletDamageScore() {
-		return totalBulletDamageScore;
+	double getTotalBulletDamageScore() const {
+		return m_pLedger->m_totalBulletDamageScore[m_id];
 	}
 
-	double getTotalBulletKillBonus() {
-		return totalBulletKillBonus;
+	double getTotalBulletKillBonus() const {
+		return m_pLedger->m_totalBulletKillBonus[m_id];
 	}
 
-	double getTotalRammingDamageScore() {
-		return totalRammingDamageScore;
+	double getTotalRammingDamageScore() const {
+		return m_pLedger->m_totalRammingDamageScore[m_id];
 	}
 
-	double getTotalRammingKillBonus() {
-		return totalRammingKillBonus;
+	double getTotalRammingKillBonus() const {
+		return m_pLedger->m_totalRammingKillBonus[m_id];
 	}
 
-	int getTotalFirsts() {
-		return totalFirsts;
+	int getTotalFirsts() const {
+		return m_pLedger->m_totalFirsts[m_id];
 	}
 
-	int getTotalSeconds() {
-		return totalSeconds;
+	int getTotalSeconds() const {
+		return m_pLedger->m_totalSeconds[m_id];
 	}
 
-	int getTotalThirds() {
-		return totalThirds;
+	int getTotalThirds() const {
+		return m_pLedger->m_totalThirds[m_id];
 	}
 
-	double getCurrentScore() {
-		return (bulletDamageScore + rammingDamageScore + survivalScore + rammingKillBonus + bulletKillBonus
-				+ lastSurvivorBonus);
+	double getCurrentScore() const {
+		return (getCurrentBulletDamageScore() + getCurrentRammingDamageScore() + getCurrentSurvivalScore()
+				+ getCurrentRammingKillBonus() + getCurrentBulletKillBonus() + getCurrentSurvivalBonus());
 	}
 
-	double getCurrentSurvivalScore() {
-		return survivalScore;
+	double getCurrentSurvivalScore() const {
+		return m_pLedger->m_survivalScore[m_id];
 	}
 
-	double getCurrentSurvivalBonus() {
-		return lastSurvivorBonus;
+	double getCurrentSurvivalBonus() const {
+		return m_pLedger->m_lastSurvivorBonus[m_id];
 	}
 
-	double getCurrentBulletDamageScore() {
-		return bulletDamageScore;
+	double getCurrentBulletDamageScore() const {
+		return m_pLedger->m_bulletDamageScore[m_id];
 	}
 
-	double getCurrentBulletKillBonus() {
-		return bulletKillBonus;
+	double getCurrentBulletKillBonus() const {
+		return m_pLedger->m_bulletKillBonus[m_id];
 	}
 
-	double getCurrentRammingDamageScore() {
-		return rammingDamageScore;
+	double getCurrentRammingDamageScore() const {
+		return m_pLedger->m_rammingDamageScore[m_id];
 	}
 
-	double getCurrentRammingKillBonus() {
-		return rammingKillBonus;
+	double getCurrentRammingKillBonus() const {
+		return m_pLedger->m_rammingKillBonus[m_id];
 	}
 
 	void scoreSurvival() {
-		if (isActive) {
-			survivalScore += 50;
+		if (isActive()) {
+			m_pLedger->m_survivalScore[m_id] += 50;
 		}
 	}
 
 	void scoreLastSurvivor() {
-		if (isActive) {
-			int enemyCount = m_numberOfRobots - 1;
+		if (isActive()) {
+			int enemyCount = m_pLedger->m_numberOfRobots - 1;
 
-			lastSurvivorBonus += 10 * enemyCount;
-			totalFirsts++;
+			m_pLedger->m_lastSurvivorBonus[m_id] += 10 * enemyCount;
+			m_pLedger->m_totalFirsts[m_id]++;
 		}
 	}
 
-	void scoreBulletDamage(std::string robot, double damage) {
-		if (isActive) {
+	void scoreBulletDamage(RobotId robot, double damage) {
+		if (isActive()) {
 			incrementRobotDamage(robot, damage);
-			bulletDamageScore += damage;
+			m_pLedger->m_bulletDamageScore[m_id] += damage;
 		}
 	}
 
-	double scoreBulletKill(std::string robot) {
-		if (isActive) {
+	double scoreBulletKill(RobotId robot) {
+		if (isActive()) {
 			double bonus = getRobotDamage(robot) * 0.20;
 
-			bulletKillBonus += bonus;
+			m_pLedger->m_bulletKillBonus[m_id] += bonus;
 			return bonus;
 		}
 		return 0;
 	}
 
-	void scoreRammingDamage(std::string robot) {
-		if (isActive) {
+	void scoreRammingDamage(RobotId robot) {
+		if (isActive()) {
 			incrementRobotDamage(robot, Rules::ROBOT_HIT_DAMAGE);
-			rammingDamageScore += Rules::ROBOT_HIT_BONUS;
+			m_pLedger->m_rammingDamageScore[m_id] += Rules::ROBOT_HIT_BONUS;
 		}
 	}
 
-	double scoreRammingKill(std::string robot) {
-		if (isActive) {
+	double scoreRammingKill(RobotId robot) {
+		if (isActive()) {
 			double bonus = getRobotDamage(robot) * 0.30;
 			
-			rammingKillBonus += bonus;
+			m_pLedger->m_rammingKillBonus[m_id] += bonus;
 			return bonus;
 		}
 		return 0;
@@ -157,73 +161,54 @@ public:
 	void scoreRobotDeath(int enemiesRemaining);
 
 	void scoreFirsts() {
-		if (isActive) {
-			totalFirsts++;
+		if (isActive()) {
+			m_pLedger->m_totalFirsts[m_id]++;
 		}
 	}
 
 	void setInactive() {
 		resetScores();
-		isActive = false;
+		m_pLedger->m_damage.clearRow( m_id );
+		m_pLedger->m_isActive[m_id] = false;
 	}
 
 	BattleResults getFinalResults();
 
-	bool isInRound() {
-		return m_bIsInRound;
+	void setRank( int newRank ) {
+		m_pLedger->m_rank[m_id] = newRank;
+	}
+
+	bool isInRound() const {
+		return m_pLedger->m_isInRound[m_id];
 	}
 
 	void cleanup() {// Do nothing, for now
 	}
 protected:
-	void resetScores() {
-		robotDamageMap.clear();
-		survivalScore = 0;
-		lastSurvivorBonus = 0;
-		bulletDamageScore = 0;
-		bulletKillBonus = 0;
-		rammingDamageScore = 0;
-		rammingKillBonus = 0;
+	bool isActive() const {
+		return m_pLedger->m_isActive[m_id];
 	}
 
-	double getRobotDamage(std::string robot) {
-		double damage = robotDamageMap[ robot ];
-
-		return damage;
+	void resetScores() {
+		ScoreLedger& l = *m_pLedger;
+		l.m_survivalScore[m_id] = 0;
+		l.m_lastSurvivorBonus[m_id] = 0;
+		l.m_bulletDamageScore[m_id] = 0;
+		l.m_bulletKillBonus[m_id] = 0;
+		l.m_rammingDamageScore[m_id] = 0;
+		l.m_rammingKillBonus[m_id] = 0;
 	}
 
-	void incrementRobotDamage(std::string robot, double damage) {
-		double newDamage = getRobotDamage(robot) + damage;
+	double getRobotDamage(RobotId robot) {
+		return m_pLedger->m_damage.get( m_id, robot );
+	}
 
-		robotDamageMap.insert( std::make_pair( robot, newDamage ) );
+	void incrementRobotDamage(RobotId robot, double damage) {
+		m_pLedger->m_damage.add( m_id, robot, damage );
 	}
 
 private:
 	Robot* m_pRobot;
-	int m_numberOfRobots;
-
-	int rank;
-	bool isActive;
-	bool m_bIsInRound;
-
-	double survivalScore;
-	double lastSurvivorBonus;
-	double bulletDamageScore;
-	double bulletKillBonus;
-	double rammingDamageScore;
-	double rammingKillBonus;
-
-	std::map<std::string, double> robotDamageMap;
-
-	double totalScore;
-	double totalSurvivalScore;
-	double totalLastSurvivorBonus;
-	double totalBulletDamageScore;
-	double totalBulletKillBonus;
-	double totalRammingDamageScore;
-	double totalRammingKillBonus;
-
-	int totalFirsts;
-	int totalSeconds;
-	int totalThirds;
-};
\ No newline at end of file
+	RobotId m_id;
+	ScoreLedger* m_pLedger;
+};
@@ -0,0 +1,171 @@
+#include "Round.hpp"
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+Round::Round( std::vector<Contestant> roster, std::size_t numRounds, std::uint64_t seed )
+: m_roster( std::move( roster ) ),
+m_numRounds( numRounds ),
+m_seed( seed )
+{
+    for( auto&& contestant : m_roster )
+    {
+        m_versions[contestant.name] = contestant.version;
+    }
+}
+
+void Round::schedule( std::vector<std::string> participants )
+{
+    std::uint64_t seed = Match::deriveSeed( m_seed, participants );
+    m_matches.emplace_back( std::move( participants ), m_numRounds, seed );
+}
+
+void Round::scheduleRoundRobin()
+{
+    scheduleMelee( 2 );
+}
+
+void Round::scheduleMelee( std::size_t groupSize )
+{
+    groupSize = std::min( groupSize, m_roster.size() );
+    if( groupSize < 2 )
+    {
+        return;
+    }
+
+    // enumerate the combinations in lexicographic order: chosen[i] is set for the members of the group
+    std::vector<bool> chosen( m_roster.size(), false );
+    std::fill( chosen.begin(), chosen.begin() + groupSize, true );
+    do
+    {
+        std::vector<std::string> participants;
+        for( std::size_t i = 0; i < m_roster.size(); ++i )
+        {
+            if( chosen[i] )
+                participants.push_back( m_roster[i].name );
+        }
+        schedule( std::move( participants ) );
+    } while( std::prev_permutation( chosen.begin(), chosen.end() ) );
+}
+
+std::size_t Round::loadResults( const std::string& fileName )
+{
+    std::ifstream file( fileName );
+    if( !file )
+    {
+        return 0;
+    }
+
+    boost::property_tree::ptree tree;
+    boost::property_tree::read_json( file, tree );
+
+    std::size_t count = 0;
+    for( auto&& match : tree )
+    {
+        std::vector<BattleResults> results;
+        for( auto&& entry : match.second )
+        {
+            results.push_back( BattleResults::load( entry.second ) );
+        }
+        m_cache[match.first] = std::move( results );
+        ++count;
+    }
+    return count;
+}
+
+void Round::saveResults( const std::string& fileName ) const
+{
+    boost::property_tree::ptree tree;
+
+    for( auto&& match : m_matches )
+    {
+        if( !match.hasResults() )
+            continue;
+
+        boost::property_tree::ptree results;
+        for( auto&& result : match.getResults() )
+        {
+            boost::property_tree::ptree entry;
+            result.save( entry );
+            results.push_back( std::make_pair( "", entry ) );
+        }
+        // names and versions may contain '.', the path separator of put(): insert instead
+        tree.push_back( std::make_pair( match.getKey( m_versions ), results ) );
+    }
+
+    boost::property_tree::write_json( fileName, tree );
+}
+
+void Round::invalidate( const std::string& name )
+{
+    for( auto&& match : m_matches )
+    {
+        if( match.involves( name ) )
+        {
+            m_cache.erase( match.getKey( m_versions ) );
+            match.clearResults();
+        }
+    }
+}
+
+std::size_t Round::run( BattleFarm& farm, bool profile /*= false*/ )
+{
+    // index of the match, index of its battle in the farm
+    std::vector<std::pair<std::size_t, std::size_t>> submitted;
+
+    for( std::size_t i = 0; i < m_matches.size(); ++i )
+    {
+        Match& match = m_matches[i];
+        if( match.hasResults() )
+            continue;
+
+        auto cached = m_cache.find( match.getKey( m_versions ) );
+        if( cached != m_cache.end() )
+        {
+            match.setResults( cached->second );
+            continue;
+        }
+
+        BattleFarm::BattleSetup setup;
+        setup.numRounds = match.getNumRounds();
+        setup.seed = match.getSeed();
+        setup.profile = profile;
+        for( auto&& name : match.getParticipants() )
+        {
+            auto contestant = std::find_if( m_roster.begin(), m_roster.end(),
+                [&name]( const Contestant& c ) { return c.name == name; } );
+            setup.robots.push_back( contestant->factory );
+        }
+
+        submitted.emplace_back( i, farm.submit( std::move( setup ) ) );
+    }
+
+    if( submitted.empty() )
+    {
+        return 0;
+    }
+
+    auto results = farm.wait();
+    for( auto&& battle : submitted )
+    {
+        Match& match = m_matches[battle.first];
+        m_cache[match.getKey( m_versions )] = results[battle.second];
+        match.setResults( std::move( results[battle.second] ) );
+    }
+
+    return submitted.size();
+}
+
+std::vector<BattleResults> Round::getLeagueTable() const
+{
+    std::vector<std::vector<BattleResults>> battles;
+    for( auto&& match : m_matches )
+    {
+        if( match.hasResults() )
+            battles.push_back( match.getResults() );
+    }
+    return BattleFarm::aggregate( battles );
+}
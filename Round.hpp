@@ -0,0 +1,95 @@
+#pragma once
+
+#include "BattleFarm.hpp"
+#include "Match.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * A robot type taking part in a tournament.
+ */
+struct Contestant
+{
+    /** The name its robots are given. */
+    std::string name;
+
+    /** Any string that changes when the robot changes, e.g. a build id or a hash of its sources. */
+    std::string version;
+
+    RobotFactory factory;
+};
+
+/**
+ * One round of a tournament: every match of a schedule over a roster, and
+ * the league table they make.
+ *
+ * Results are cached by match key (see Match::getKey()), and the cache can
+ * be saved and loaded between runs: when only one contestant changed, only
+ * the matches it takes part in are run again.
+ */
+class Round
+{
+public:
+    Round( std::vector<Contestant> roster, std::size_t numRounds, std::uint64_t seed );
+
+    /**
+     * Schedules every 1v1 pairing of the roster.
+     */
+    void scheduleRoundRobin();
+
+    /**
+     * Schedules every melee group of the given size that can be drawn from
+     * the roster, i.e. a single match with everybody when the size is the
+     * size of the roster.
+     */
+    void scheduleMelee( std::size_t groupSize );
+
+    const std::vector<Match>& getMatches() const { return m_matches; }
+
+    /**
+     * Reads results cached by saveResults(). A missing file is an empty cache.
+     *
+     * @return the number of cached matches read
+     */
+    std::size_t loadResults( const std::string& fileName );
+
+    /**
+     * Writes the results of the scheduled matches.
+     */
+    void saveResults( const std::string& fileName ) const;
+
+    /**
+     * Forgets the results of every match the given contestant takes part in,
+     * e.g. when it changed without its version being bumped.
+     */
+    void invalidate( const std::string& name );
+
+    /**
+     * Runs the scheduled matches whose results are not cached, on the farm,
+     * and waits for them.
+     *
+     * @param farm the farm to run the matches on
+     * @param profile whether to profile the matches, see BattleFarm::getProfile()
+     * @return the number of matches run
+     */
+    std::size_t run( BattleFarm& farm, bool profile = false );
+
+    /**
+     * Returns the results of all the matches summed per contestant, ranked by score.
+     */
+    std::vector<BattleResults> getLeagueTable() const;
+
+private:
+    void schedule( std::vector<std::string> participants );
+
+    std::vector<Contestant> m_roster;
+    std::map<std::string, std::string> m_versions;
+    std::size_t m_numRounds;
+    std::uint64_t m_seed;
+
+    std::vector<Match> m_matches;
+    std::map<std::string, std::vector<BattleResults>> m_cache;
+};
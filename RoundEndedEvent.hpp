@@ -5,6 +5,8 @@
 class RoundEndedEvent : public Event
 {
 public:
+	static constexpr int DEFAULT_PRIORITY = 110;
+
 	RoundEndedEvent()
 	{
 	}
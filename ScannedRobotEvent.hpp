@@ -8,6 +8,7 @@
 #pragma once
 
 #include "Event.hpp"
+#include "RobotNameTable.hpp"
 
 #include "Utils.hpp"
 
@@ -29,20 +30,24 @@ class ScannedRobotEvent : public Event
 {
 private:
 
-	const std::string m_name;
-	const double m_energy;
-	const double m_heading;
-	const double m_bearing;
-	const double m_distance;
-	const double m_velocity;
-	const bool m_isSentryRobot;
+	const RobotNameTable* m_pNames;
+	RobotId m_robot;
+	double m_energy;
+	double m_heading;
+	double m_bearing;
+	double m_distance;
+	double m_velocity;
+	bool m_isSentryRobot;
 
 public:
 
+	static constexpr int DEFAULT_PRIORITY = 10;
+
 	/**
 	 * Called by the game to create a new ScannedRobotEvent.
 	 *
-	 * @param name	 the name of the scanned robot
+	 * @param names	 the robots of the battle
+	 * @param robot	 the id of the scanned robot
 	 * @param energy   the energy of the scanned robot
 	 * @param bearing  the bearing of the scanned robot, in radians
 	 * @param distance the distance from your robot to the scanned robot
@@ -52,8 +57,9 @@ public:
 	 * 
 	 * @since 1.9.0.0
 	 */
-	ScannedRobotEvent( std::string name, double energy, double bearing, double distance, double heading, double velocity, bool isSentryRobot = false )
-	 : m_name( name ),
+	ScannedRobotEvent( const RobotNameTable& names, RobotId robot, double energy, double bearing, double distance, double heading, double velocity, bool isSentryRobot = false )
+	 : m_pNames( &names ),
+		m_robot( robot ),
 		m_energy( energy ),
 		m_heading( heading ),
 		m_bearing( bearing ),
@@ -132,8 +138,17 @@ public:
 	 *
 	 * @return the name of the robot
 	 */
-	std::string getName() {
-		return m_name;
+	const std::string& getName() {
+		return m_pNames->getName( m_robot );
+	}
+
+	/**
+	 * Returns the id of the robot, within the battle.
+	 *
+	 * @return the id of the robot
+	 */
+	RobotId getRobotId() const {
+		return m_robot;
 	}
 
 	/**
@@ -204,7 +219,7 @@ public:
 	 * @return the name of the robot
 	 * @deprecated Use {@link #getName()} instead.
 	 */
-	std::string getRobotName() {
+	const std::string& getRobotName() {
 		return getName();
 	}
 
@@ -228,20 +243,14 @@ public:
 	/**
 	 * {@inheritDoc}
 	 */
-	int compareTo( Event* event ) const
+	int compareTo( const ScannedRobotEvent& event ) const
 	{
-		int res = 0; //super.compareTo(event);
-		if (res != 0) {
-			return res;
-		}
-		// Compare the distance, if the events are ScannedRobotEvents
+		// Compare the distance
 		// The shorter distance to the robot, the higher priority
-		auto pSre = dynamic_cast<ScannedRobotEvent*>( event );
-		if( pSre != nullptr )
+		if( getDistance() < event.getDistance() )
 		{
-			return (int) (getDistance() - pSre->getDistance());
+			return -1;
 		}
-		// No difference found
-		return 0;
+		return getDistance() > event.getDistance() ? 1 : 0;
 	}
 };
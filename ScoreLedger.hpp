@@ -0,0 +1,114 @@
+#pragma once
+
+#include "DamageMatrix.hpp"
+#include "RobotNameTable.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * The scores of the robots of a battle, one array per score indexed by
+ * robot id. Each robot updates its row in place through its
+ * RobotStatistics; the ledger also keeps the damage the robots dealt each
+ * other, and how many robots are still alive in the current round, so that
+ * a robot dying is placed without counting the survivors.
+ */
+class ScoreLedger
+{
+public:
+    ScoreLedger()
+    : m_numberOfRobots( 0 ),
+    m_survivorCount( 0 )
+    {
+    }
+
+    /**
+     * Makes room for the scores of the given number of robots, the new
+     * ones starting from zero.
+     */
+    void fit( std::size_t numRobots )
+    {
+        if( numRobots <= m_rank.size() )
+        {
+            return;
+        }
+
+        for( std::vector<double>* pColumn : { &m_survivalScore, &m_lastSurvivorBonus, &m_bulletDamageScore, &m_bulletKillBonus,
+                                              &m_rammingDamageScore, &m_rammingKillBonus, &m_totalScore, &m_totalSurvivalScore,
+                                              &m_totalLastSurvivorBonus, &m_totalBulletDamageScore, &m_totalBulletKillBonus,
+                                              &m_totalRammingDamageScore, &m_totalRammingKillBonus } )
+        {
+            pColumn->resize( numRobots, 0. );
+        }
+        for( std::vector<int>* pColumn : { &m_rank, &m_totalFirsts, &m_totalSeconds, &m_totalThirds } )
+        {
+            pColumn->resize( numRobots, 0 );
+        }
+        m_isActive.resize( numRobots, false );
+        m_isInRound.resize( numRobots, false );
+    }
+
+    /**
+     * Starts a round with the given number of robots: none of them has dealt
+     * any damage yet, and all of them are alive.
+     */
+    void beginRound( int numberOfRobots )
+    {
+        m_numberOfRobots = numberOfRobots;
+        m_survivorCount = numberOfRobots;
+        m_damage.clear();
+    }
+
+    /**
+     * Tells that a robot died.
+     */
+    void removeSurvivor()
+    {
+        --m_survivorCount;
+    }
+
+    /**
+     * Returns the number of robots still alive in the current round.
+     */
+    int getSurvivorCount() const
+    {
+        return m_survivorCount;
+    }
+
+    DamageMatrix& getDamage()
+    {
+        return m_damage;
+    }
+
+private:
+    friend class RobotStatistics;
+
+    int m_numberOfRobots;
+    int m_survivorCount;
+
+    DamageMatrix m_damage;
+
+    std::vector<double> m_survivalScore;
+    std::vector<double> m_lastSurvivorBonus;
+    std::vector<double> m_bulletDamageScore;
+    std::vector<double> m_bulletKillBonus;
+    std::vector<double> m_rammingDamageScore;
+    std::vector<double> m_rammingKillBonus;
+
+    std::vector<double> m_totalScore;
+    std::vector<double> m_totalSurvivalScore;
+    std::vector<double> m_totalLastSurvivorBonus;
+    std::vector<double> m_totalBulletDamageScore;
+    std::vector<double> m_totalBulletKillBonus;
+    std::vector<double> m_totalRammingDamageScore;
+    std::vector<double> m_totalRammingKillBonus;
+
+    std::vector<int> m_rank;
+    std::vector<int> m_totalFirsts;
+    std::vector<int> m_totalSeconds;
+    std::vector<int> m_totalThirds;
+
+    std::vector<bool> m_isActive;
+    std::vector<bool> m_isInRound;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Profiler.hpp"
+#include "RandomStream.hpp"
+#include "RobotNameTable.hpp"
+#include "ScoreLedger.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Simulation state owned by a single World: the random generator, the id
+ * generators, the robot names, their scores and the profiler. Nothing in here is shared between worlds, so battles running
+ * concurrently neither contend with nor corrupt each other.
+ */
+class SimulationContext
+{
+public:
+    SimulationContext()
+    // worlds created at the same time in different threads must not share a seed
+    : m_random( std::chrono::system_clock::now().time_since_epoch().count() + reinterpret_cast<std::uintptr_t>( this ) ),
+    m_lastBulletId( 0 )
+    {
+    }
+
+    /**
+     * Returns the random number generator of this world.
+     *
+     * @return random number generator
+     */
+    RandomStream& getRandom()
+    {
+        return m_random;
+    }
+
+    /**
+     * Restarts the random number generator on the given stream of a seed,
+     * and the id generators from scratch, e.g. at the beginning of a round.
+     *
+     * @param seed the seed
+     * @param stream the index of the stream derived from the seed
+     */
+    void seed( std::uint64_t seed, std::uint64_t stream = 0 )
+    {
+        m_random = RandomStream( seed, stream );
+        m_lastBulletId = 0;
+    }
+
+    /**
+     * Returns a new bullet id, unique within this world.
+     *
+     * @return the bullet id
+     */
+    int nextBulletId()
+    {
+        return ++m_lastBulletId;
+    }
+
+    /**
+     * Returns the ids and names of the robots of this world's battle. Unlike
+     * the other ids, they are kept from one round to the next.
+     *
+     * @return robot names
+     */
+    RobotNameTable& getRobotNames()
+    {
+        return m_robotNames;
+    }
+
+    /**
+     * Returns the scores of the robots of this world's battle, and the
+     * damage they dealt each other this round.
+     *
+     * @return score ledger
+     */
+    ScoreLedger& getScoreLedger()
+    {
+        return m_scores;
+    }
+
+    /**
+     * Returns the profiler of this world's ticks.
+     *
+     * @return profiler
+     */
+    Profiler& getProfiler()
+    {
+        return m_profiler;
+    }
+
+private:
+    RandomStream m_random;
+    int m_lastBulletId;
+    RobotNameTable m_robotNames;
+    ScoreLedger m_scores;
+    Profiler m_profiler;
+};
@@ -0,0 +1,118 @@
+#include "SimulationThread.hpp"
+
+#include "Battle.hpp"
+#include "World.hpp"
+
+#include <chrono>
+#include <iostream>
+
+SimulationThread::SimulationThread( Battle& battle, World& world, TripleBuffer<WorldSnapshot>& snapshots,
+                                    double ticksPerSecond, double displayRate /*= 60*/ )
+: m_battle( battle ),
+m_world( world ),
+m_snapshots( snapshots ),
+m_ticksPerSecond( ticksPerSecond ),
+m_displayRate( displayRate ),
+m_speed( 1 ),
+m_profiling( false ),
+m_running( false )
+{
+}
+
+SimulationThread::~SimulationThread()
+{
+    stop();
+}
+
+void SimulationThread::start()
+{
+    m_running = true;
+    m_thread = std::thread( &SimulationThread::run, this );
+}
+
+void SimulationThread::stop()
+{
+    m_running = false;
+    if( m_thread.joinable() )
+    {
+        m_thread.join();
+    }
+}
+
+void SimulationThread::setSpeed( unsigned speed )
+{
+    m_speed = speed;
+}
+
+unsigned SimulationThread::getSpeed() const
+{
+    return m_speed;
+}
+
+void SimulationThread::setProfiling( bool profiling )
+{
+    m_profiling = profiling;
+}
+
+bool SimulationThread::isProfiling() const
+{
+    return m_profiling;
+}
+
+void SimulationThread::updateProfiling()
+{
+    Profiler& profiler = m_world.getContext().getProfiler();
+    bool profiling = m_profiling;
+
+    if( profiler.isEnabled() && ( !profiling || m_battle.ended() || !m_running ) )
+    {
+        std::cout << "SYSTEM: tick profile" << std::endl;
+        profiler.report( std::cout );
+        profiler.clear();
+    }
+
+    profiler.setEnabled( profiling && !m_battle.ended() && m_running );
+}
+
+void SimulationThread::run()
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const auto displayPeriod = std::chrono::duration_cast<Clock::duration>( std::chrono::duration<double>( 1. / m_displayRate ) );
+    auto deadline = Clock::now();
+    auto nextPublish = deadline;
+
+    while( m_running && !m_battle.ended() )
+    {
+        updateProfiling();
+
+        m_battle.tick();
+
+        auto now = Clock::now();
+
+        // render decimation: only the last tick of each display period is published
+        if( now >= nextPublish || m_battle.ended() )
+        {
+            m_world.takeSnapshot( m_snapshots.back() );
+            m_snapshots.publish();
+            nextPublish = now + displayPeriod;
+        }
+
+        unsigned speed = m_speed;
+        if( speed == UNLIMITED )
+        {
+            deadline = now;
+            continue;
+        }
+
+        deadline += std::chrono::duration_cast<Clock::duration>( std::chrono::duration<double>( 1. / ( m_ticksPerSecond * speed ) ) );
+        if( deadline < now )
+        {
+            // too late: do not try to catch up with the missed ticks
+            deadline = now;
+        }
+        std::this_thread::sleep_until( deadline );
+    }
+
+    updateProfiling();
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "TripleBuffer.hpp"
+#include "WorldSnapshot.hpp"
+
+#include <atomic>
+#include <thread>
+
+class Battle;
+class World;
+
+/**
+ * Ticks a battle on its own thread at a fixed rate, and publishes a snapshot
+ * of the world after each tick for the renderer to pick up. Rendering and
+ * simulation overlap instead of adding their latencies together.
+ *
+ * The tick rate can be multiplied at runtime, up to unlimited. Snapshots are
+ * never published faster than the display rate, so in the fast modes most
+ * ticks are not rendered at all.
+ *
+ * Profiling of the ticks can be toggled at runtime too; the report is
+ * printed when it is turned off and when the battle ends.
+ */
+class SimulationThread
+{
+public:
+    /** Speed multiplier meaning "as fast as possible". */
+    static constexpr unsigned UNLIMITED = 0;
+
+    SimulationThread( Battle& battle, World& world, TripleBuffer<WorldSnapshot>& snapshots,
+                      double ticksPerSecond, double displayRate = 60 );
+    ~SimulationThread();
+
+    SimulationThread( const SimulationThread& ) = delete;
+    SimulationThread& operator=( const SimulationThread& ) = delete;
+
+    void start();
+    void stop();
+
+    /**
+     * Sets the speed as a multiple of the nominal tick rate, or UNLIMITED.
+     */
+    void setSpeed( unsigned speed );
+    unsigned getSpeed() const;
+
+    void setProfiling( bool profiling );
+    bool isProfiling() const;
+
+private:
+    void run();
+
+    /**
+     * Applies the requested profiling state to the world, from the simulation thread.
+     */
+    void updateProfiling();
+
+    Battle& m_battle;
+    World& m_world;
+    TripleBuffer<WorldSnapshot>& m_snapshots;
+    double m_ticksPerSecond;
+    double m_displayRate;
+
+    std::atomic<unsigned> m_speed;
+    std::atomic<bool> m_profiling;
+    std::atomic<bool> m_running;
+    std::thread m_thread;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * The sine and cosine of an angle, computed together.
+ *
+ * The angle is reduced to [-PI/4, PI/4] by a multiple of PI/2 (Cody-Waite,
+ * with PI/2 split in four parts, keeping the rounding error of the reduced
+ * angle), then both are evaluated with the minimax polynomials of fdlibm's
+ * __kernel_sin and __kernel_cos. The quadrant is applied with selects rather
+ * than branches, so that a loop computing many of them vectorises.
+ *
+ * For |angle| <= MAX_ANGLE, sin() and cos() are within 1 ulp of the exact
+ * values (0.79 ulp at most on 60M random angles, 0.61 ulp on multiples of
+ * PI/2), which `robocodepp-bench --verify-sincos` checks. Beyond it, the
+ * reduction loses precision.
+ */
+class SinCos
+{
+public:
+    /** The largest angle, in radians, for which the error bound holds. */
+    static constexpr double MAX_ANGLE = 1 << 20;
+
+    SinCos()
+    : m_sin( 0 ),
+    m_cos( 1 )
+    {
+    }
+
+    /**
+     * @param angle the angle, in radians
+     */
+    explicit SinCos( double angle )
+    {
+        // 33 + 33 + 33 + 53 bits of PI/2: the first three times k are exact for |k| < 2^20
+        const double PIO2_1 = 1.57079632673412561417e+00;
+        const double PIO2_2 = 6.07710050630396597660e-11;
+        const double PIO2_3 = 2.02226624871116645580e-21;
+        const double PIO2_3T = 8.47842766036889956997e-32;
+        const double TWO_OVER_PI = 6.36619772367581382433e-01;
+
+        // angle - k * PI/2 = x + y, y being what x is too short to hold
+        double k = std::nearbyint( angle * TWO_OVER_PI );
+        double r = angle - k * PIO2_1;
+        double h = r - k * PIO2_2;
+        double l = ( ( r - h ) - k * PIO2_2 ) - ( k * PIO2_3 + k * PIO2_3T );
+        double x = h + l;
+        double y = ( h - x ) + l;
+        double z = x * x;
+
+        const double S1 = -1.66666666666666324348e-01;
+        const double S2 = 8.33333333332248946124e-03;
+        const double S3 = -1.98412698298579493134e-04;
+        const double S4 = 2.75573137070700676789e-06;
+        const double S5 = -2.50507602534068634195e-08;
+        const double S6 = 1.58969099521155010221e-10;
+        double v = z * x;
+        double ps = S2 + z * ( S3 + z * ( S4 + z * ( S5 + z * S6 ) ) );
+        double s = x - ( ( z * ( 0.5 * y - v * ps ) - y ) - v * S1 );
+
+        const double C1 = 4.16666666666666019037e-02;
+        const double C2 = -1.38888888888741095749e-03;
+        const double C3 = 2.48015872894767294178e-05;
+        const double C4 = -2.75573143513906633035e-07;
+        const double C5 = 2.08757232129817482790e-09;
+        const double C6 = -1.13596475577881948265e-11;
+        double pc = z * ( C1 + z * ( C2 + z * ( C3 + z * ( C4 + z * ( C5 + z * C6 ) ) ) ) );
+        double hz = 0.5 * z;
+        double w = 1 - hz;
+        double c = w + ( ( ( 1 - w ) - hz ) + ( z * pc - x * y ) );
+
+        // angle = k * PI/2 + x: turn (s, c) by k quarters
+        std::int32_t quadrant = std::int32_t( k );
+        bool swap = quadrant & 1;
+        double sine = swap ? c : s;
+        double cosine = swap ? s : c;
+        m_sin = ( quadrant & 2 ) ? -sine : sine;
+        m_cos = ( ( quadrant + 1 ) & 2 ) ? -cosine : cosine;
+    }
+
+    double sin() const { return m_sin; }
+    double cos() const { return m_cos; }
+    double tan() const { return m_sin / m_cos; }
+
+private:
+    double m_sin;
+    double m_cos;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Non-owning view over contiguous elements, to hand out the content of a
+ * container without copying it (std::span is C++20).
+ *
+ * Like any pointer into a std::vector, a span is invalidated when the
+ * vector reallocates.
+ */
+template <typename T>
+class Span
+{
+public:
+    typedef T value_type;
+    typedef T* iterator;
+
+    Span()
+    : m_pData( nullptr ),
+    m_size( 0 )
+    {
+    }
+
+    Span( T* pData, std::size_t size )
+    : m_pData( pData ),
+    m_size( size )
+    {
+    }
+
+    template <typename U, typename Allocator>
+    Span( std::vector<U, Allocator>& vector )
+    : m_pData( vector.data() ),
+    m_size( vector.size() )
+    {
+    }
+
+    template <typename U, typename Allocator>
+    Span( const std::vector<U, Allocator>& vector )
+    : m_pData( vector.data() ),
+    m_size( vector.size() )
+    {
+    }
+
+    T* begin() const { return m_pData; }
+    T* end() const { return m_pData + m_size; }
+
+    T& operator[]( std::size_t index ) const { return m_pData[index]; }
+    T& front() const { return m_pData[0]; }
+    T& back() const { return m_pData[m_size - 1]; }
+
+    T* data() const { return m_pData; }
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+private:
+    T* m_pData;
+    std::size_t m_size;
+};
@@ -0,0 +1,163 @@
+#include "SweepAndPrune.hpp"
+
+#include "Robot.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+SweepAndPrune::SweepAndPrune()
+: m_margin( 0 ),
+m_stale( true ),
+m_maxWidth( 0 )
+{
+}
+
+void SweepAndPrune::build( Span<Robot*> robots, double margin )
+{
+    m_margin = margin;
+    m_stale = false;
+
+    m_entries.clear();
+    m_x.resize( robots.size() );
+    m_y.resize( robots.size() );
+    for( std::uint32_t i = 0; i < robots.size(); ++i )
+    {
+        sf::FloatRect box = robots[i]->getBoundingBox();
+
+        Entry entry;
+        entry.minX = box.left - margin;
+        entry.maxX = double( box.left ) + box.width + margin;
+        entry.minY = box.top - margin;
+        entry.maxY = double( box.top ) + box.height + margin;
+        entry.index = i;
+        entry.box = box;
+        m_entries.push_back( entry );
+
+        m_x[i] = box.left;
+        m_y[i] = box.top;
+    }
+
+    std::sort( m_entries.begin(), m_entries.end(),
+        []( const Entry& a, const Entry& b ) { return a.minX < b.minX || ( a.minX == b.minX && a.index < b.index ); } );
+
+    // sweep twice: count the pairs of each robot, then fill them in
+    m_pairStart.assign( robots.size() + 1, 0 );
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        if( pass == 1 )
+        {
+            for( std::size_t i = 1; i < m_pairStart.size(); ++i )
+            {
+                m_pairStart[i] += m_pairStart[i - 1];
+            }
+            m_pairs.resize( m_pairStart.back() );
+        }
+
+        for( std::size_t a = 0; a < m_entries.size(); ++a )
+        {
+            const Entry& first = m_entries[a];
+            for( std::size_t b = a + 1; b < m_entries.size() && m_entries[b].minX <= first.maxX; ++b )
+            {
+                const Entry& second = m_entries[b];
+                if( second.minY > first.maxY || second.maxY < first.minY )
+                    continue;
+
+                if( pass == 0 )
+                {
+                    ++m_pairStart[first.index + 1];
+                    ++m_pairStart[second.index + 1];
+                }
+                else
+                {
+                    // fill from the end of each list, counting down to its start
+                    m_pairs[--m_pairStart[first.index + 1]] = second.index;
+                    m_pairs[--m_pairStart[second.index + 1]] = first.index;
+                }
+            }
+        }
+    }
+
+    // the cursors ended on the start of the next list: shift them back
+    for( std::size_t i = 0; i + 1 < m_pairStart.size(); ++i )
+    {
+        m_pairStart[i] = m_pairStart[i + 1];
+    }
+    m_pairStart.back() = m_pairs.size();
+
+    // in world order, like a loop over all the robots
+    for( std::size_t i = 0; i + 1 < m_pairStart.size(); ++i )
+    {
+        std::sort( m_pairs.begin() + m_pairStart[i], m_pairs.begin() + m_pairStart[i + 1] );
+    }
+
+    m_all.resize( robots.size() );
+    for( std::uint32_t i = 0; i < robots.size(); ++i )
+    {
+        m_all[i] = i;
+    }
+}
+
+void SweepAndPrune::track( std::uint32_t index, const sf::FloatRect& box )
+{
+    if( m_stale || index >= m_x.size() )
+    {
+        m_stale = true;
+        return;
+    }
+
+    if( std::abs( box.left - m_x[index] ) > m_margin || std::abs( box.top - m_y[index] ) > m_margin )
+    {
+        m_stale = true;
+    }
+}
+
+Span<const std::uint32_t> SweepAndPrune::getCandidates( std::uint32_t index ) const
+{
+    if( m_stale || index + 1 >= m_pairStart.size() )
+    {
+        return m_all;
+    }
+    return Span<const std::uint32_t>( m_pairs.data() + m_pairStart[index], m_pairStart[index + 1] - m_pairStart[index] );
+}
+
+void SweepAndPrune::clear()
+{
+    m_entries.clear();
+    m_maxWidth = 0;
+    m_stale = true;
+}
+
+void SweepAndPrune::insert( std::uint32_t index, const sf::FloatRect& box )
+{
+    Entry entry;
+    entry.minX = box.left;
+    entry.maxX = double( box.left ) + box.width;
+    entry.minY = box.top;
+    entry.maxY = double( box.top ) + box.height;
+    entry.index = index;
+    entry.box = box;
+
+    auto position = std::upper_bound( m_entries.begin(), m_entries.end(), entry.minX,
+        []( double minX, const Entry& e ) { return minX < e.minX; } );
+    m_entries.insert( position, entry );
+
+    m_maxWidth = std::max( m_maxWidth, double( box.width ) );
+}
+
+bool SweepAndPrune::overlaps( const sf::FloatRect& box ) const
+{
+    // one pixel of slack: the exact test is left to sf::FloatRect, in float
+    double minX = box.left - m_maxWidth - 1;
+    double maxX = double( box.left ) + box.width + 1;
+
+    auto it = std::lower_bound( m_entries.begin(), m_entries.end(), minX,
+        []( const Entry& e, double minX ) { return e.minX < minX; } );
+    for( ; it != m_entries.end() && it->minX <= maxX; ++it )
+    {
+        if( box.intersects( it->box ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
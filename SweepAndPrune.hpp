@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Span.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Robot;
+
+/**
+ * Sort-and-sweep broadphase of the robot-robot overlaps, on the x axis.
+ *
+ * During a tick, build() sorts the robots once and lists, for each robot,
+ * the robots whose boxes grown by a margin overlap its own: as long as no
+ * robot moves further than the margin, they are the only ones it can
+ * collide with. A robot moving further makes the lists stale, and
+ * getCandidates() then returns every robot.
+ *
+ * While a round is set up, insert() and overlaps() keep the boxes placed so
+ * far sorted, so that each placement attempt only looks at its neighbours.
+ *
+ * Robots are designated by their index in the World.
+ */
+class SweepAndPrune
+{
+public:
+    SweepAndPrune();
+
+    /**
+     * Lists the candidate pairs of the given robots for this tick.
+     *
+     * @param robots the robots, dead or alive
+     * @param margin how far a robot can move before the lists go stale
+     */
+    void build( Span<Robot*> robots, double margin );
+
+    /**
+     * Tells that the box of a robot moved, making the lists stale if it went further than the margin.
+     */
+    void track( std::uint32_t index, const sf::FloatRect& box );
+
+    /**
+     * Returns the indices of the robots that may overlap the given one, in
+     * increasing order, the robot itself excluded unless the lists are stale.
+     */
+    Span<const std::uint32_t> getCandidates( std::uint32_t index ) const;
+
+    /**
+     * Returns whether a robot moved further than the margin since build(),
+     * or the robots changed: the lists, and any index built with them, are out of date.
+     */
+    bool isStale() const { return m_stale; }
+
+    /**
+     * Tells that the robots changed, until the next build().
+     */
+    void invalidate() { m_stale = true; }
+
+    double getMargin() const { return m_margin; }
+
+    /**
+     * Forgets every box, before a round is set up.
+     */
+    void clear();
+
+    /**
+     * Adds a placed box.
+     */
+    void insert( std::uint32_t index, const sf::FloatRect& box );
+
+    /**
+     * Returns whether a box intersects one of the placed ones, in the sense of sf::FloatRect::intersects().
+     */
+    bool overlaps( const sf::FloatRect& box ) const;
+
+private:
+    struct Entry
+    {
+        double minX;
+        double maxX;
+        double minY;
+        double maxY;
+        std::uint32_t index;
+        sf::FloatRect box;
+    };
+
+    double m_margin;
+    bool m_stale;
+
+    /** Sorted by minX. */
+    std::vector<Entry> m_entries;
+
+    /** Widest box inserted, to bound the search of overlaps(). */
+    double m_maxWidth;
+
+    /** Corner of the box of each robot at build(). */
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+
+    /** m_pairStart[i] to m_pairStart[i + 1] are the candidates of robot i. */
+    std::vector<std::uint32_t> m_pairStart;
+    std::vector<std::uint32_t> m_pairs;
+
+    /** 0 to n - 1, returned when the lists are stale. */
+    std::vector<std::uint32_t> m_all;
+};
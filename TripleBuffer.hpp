@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Lock-free single producer / single consumer triple buffer.
+ *
+ * The producer fills the back buffer and publishes it, the consumer picks
+ * up the most recently published buffer. Neither side ever waits for the
+ * other: the producer always has a free buffer to write into, and buffers
+ * published while the consumer was busy are simply skipped.
+ */
+template<class T>
+class TripleBuffer
+{
+public:
+    TripleBuffer()
+    : m_back( 0 ),
+    m_middle( 1 ),
+    m_front( 2 )
+    {
+    }
+
+    /**
+     * Returns the buffer the producer may fill.
+     */
+    T& back()
+    {
+        return m_buffers[m_back];
+    }
+
+    /**
+     * Makes the back buffer available to the consumer. Producer side.
+     */
+    void publish()
+    {
+        m_back = m_middle.exchange( m_back | DIRTY, std::memory_order_acq_rel ) & INDEX;
+    }
+
+    /**
+     * Picks up the last published buffer, if any. Consumer side.
+     *
+     * @return true if front() changed since the previous call
+     */
+    bool update()
+    {
+        if( !( m_middle.load( std::memory_order_relaxed ) & DIRTY ) )
+        {
+            return false;
+        }
+
+        m_front = m_middle.exchange( m_front, std::memory_order_acq_rel ) & INDEX;
+        return true;
+    }
+
+    /**
+     * Returns the buffer the consumer may read.
+     */
+    const T& front() const
+    {
+        return m_buffers[m_front];
+    }
+
+private:
+    static constexpr std::uint8_t INDEX = 0x3;
+    static constexpr std::uint8_t DIRTY = 0x4;
+
+    T m_buffers[3];
+
+    std::uint8_t m_back;
+    std::atomic<std::uint8_t> m_middle;
+    std::uint8_t m_front;
+};
@@ -55,9 +55,8 @@ namespace
     }
 }
 
-UI::UI( sf::RenderWindow& window, World& world )
-: m_window( window ),
-m_world( world )
+UI::UI( sf::RenderWindow& window )
+: m_window( window )
 {
     m_groundTexture += "images/ground/blue_metal/blue_metal_1.png";
     m_font += "fonts/Inconsolata-Regular.ttf";
@@ -68,13 +67,13 @@ m_world( world )
     }
 }
 
-void UI::draw()
+void UI::draw( const WorldSnapshot& world )
 {
     m_window.clear();
 
-    for( unsigned int x = 0; x < m_world.getWidth(); x += m_groundTexture.getSize().x )
+    for( unsigned int x = 0; x < world.width; x += m_groundTexture.getSize().x )
     {
-        for( unsigned int y = 0; y < m_world.getHeight(); y += m_groundTexture.getSize().y )
+        for( unsigned int y = 0; y < world.height; y += m_groundTexture.getSize().y )
         {
             sf::Sprite groundSprite( m_groundTexture );
 
@@ -84,71 +83,78 @@ void UI::draw()
         }
     }
 
-    for( auto&& pRobot : m_world.getRobots() )
+    for( auto&& robot : world.robots )
     {
-        auto& robot = *pRobot;
-
         std::stringstream ss;
-        ss << (int) robot.getEnergy();
+        ss << (int) robot.energy;
         sf::Text energyText( ss.str(), m_font, 15 );
-        energyText.setPosition( robot.getX() - energyText.getString().getSize() * 15. / 4.,
-                                m_world.getHeight() - robot.getY() - Robot::HALF_HEIGHT_OFFSET - 15 - 10 );
+        energyText.setPosition( robot.x - energyText.getString().getSize() * 15. / 4.,
+                                world.height - robot.y - Robot::HALF_HEIGHT_OFFSET - 15 - 10 );
         m_window.draw( energyText );
-        m_window.draw( makeSprite( makeTexture( "body",   robot.getBodyColor() ),  robot.getX(), m_world.getHeight()-robot.getY(), robot.getAngle() ) );
-        m_window.draw( makeSprite( makeTexture( "turret", robot.getGunColor() ),   robot.getX(), m_world.getHeight()-robot.getY(), robot.getTurretAngle() ) );
-        m_window.draw( makeSprite( makeTexture( "radar",  robot.getRadarColor() ), robot.getX(), m_world.getHeight()-robot.getY(), robot.getRadarAngle() ) ); 
-        sf::Text nameText( robot.getName(), m_font, 15 );
-        nameText.setPosition( robot.getX() - nameText.getString().getSize() * 15. / 4.,
-                              m_world.getHeight() - robot.getY() + Robot::HALF_HEIGHT_OFFSET + 10 );
+        m_window.draw( makeSprite( makeTexture( "body",   robot.bodyColor ),  robot.x, world.height-robot.y, robot.bodyAngle ) );
+        m_window.draw( makeSprite( makeTexture( "turret", robot.gunColor ),   robot.x, world.height-robot.y, robot.turretAngle ) );
+        m_window.draw( makeSprite( makeTexture( "radar",  robot.radarColor ), robot.x, world.height-robot.y, robot.radarAngle ) ); 
+        sf::Text nameText( *robot.name, m_font, 15 );
+        nameText.setPosition( robot.x - nameText.getString().getSize() * 15. / 4.,
+                              world.height - robot.y + Robot::HALF_HEIGHT_OFFSET + 10 );
         m_window.draw( nameText );
 
-        Arc2D robotScanArc = robot.getScanArc();
         sf::ConvexShape scanArc;
         scanArc.setPointCount(3);
-        //scanArc.setPoint( 0, sf::Vector2f(robotScanArc.origin().x(), robotScanArc.origin().y()) );
-        //scanArc.setPoint( 1, sf::Vector2f(robotScanArc.origin().x(), robotScanArc.origin().y()) );
-        //scanArc.setPoint( 2, sf::Vector2f(robotScanArc.origin().x(), robotScanArc.origin().y()) );
-        scanArc.setPoint( 0, sf::Vector2f(robotScanArc.origin().x(), m_world.getHeight() -robotScanArc.origin().y()) );
-        scanArc.setPoint( 1, sf::Vector2f(robotScanArc.start().x(), m_world.getHeight() -robotScanArc.start().y()) );
-        scanArc.setPoint( 2, sf::Vector2f(robotScanArc.end().x(), m_world.getHeight() -robotScanArc.end().y()) );
+        for( std::size_t i = 0; i < 3; ++i )
+        {
+            scanArc.setPoint( i, sf::Vector2f(robot.scanX[i], world.height - robot.scanY[i]) );
+        }
         scanArc.setFillColor( sf::Color(150, 50, 250, 42) );
         m_window.draw( scanArc );
     }
 
-    for( auto&& b : m_world.getBullets() )
+    for( auto&& b : world.bullets )
     {
-        auto state = b.getState();
+        auto state = b.state;
         if(    state == Bullet::EXPLODED
             || state == Bullet::HIT_BULLET
             || state == Bullet::HIT_VICTIM
             || state == Bullet::HIT_WALL )
         {
-            auto frame = b.getFrame();
-            double scale = std::sqrt( 1000 * b.getPower()) / 128;
+            auto frame = b.frame;
+            double scale = std::sqrt( 1000 * b.power) / 128;
 
             if( frame < 1 || frame > 17 ) // sanity check
                 continue;
 
             sf::Sprite expl( m_explosionTextures[frame] );
             expl.setOrigin( sf::Vector2f( m_explosionTextures[frame].getSize().x/2, m_explosionTextures[frame].getSize().y/2 ) );
-            expl.setPosition( b.getX(), m_world.getHeight()-b.getY() );
+            expl.setPosition( b.x, world.height-b.y );
             expl.setScale( scale, scale );
             m_window.draw( expl );
         }
         else
         {
-            sf::CircleShape bullet( b.getPower() );
+            sf::CircleShape bullet( b.power );
 
-            bullet.setFillColor( b.getColor() );
-            bullet.setPosition( b.getX(), m_world.getHeight()-b.getY() );
+            bullet.setFillColor( b.color );
+            bullet.setPosition( b.x, world.height-b.y );
             
             m_window.draw( bullet );
         }
     }
 
+    if( !m_status.empty() )
+    {
+        sf::Text statusText( m_status, m_font, 15 );
+        statusText.setPosition( 5, 5 );
+        m_window.draw( statusText );
+    }
+
     m_window.display();
 }
 
+void UI::setStatus( const std::string& status )
+{
+    m_status = status;
+}
+
 const sf::Texture& UI::makeTexture( const std::string& part, sf::Color color )
 {
     std::stringstream ss;
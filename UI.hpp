@@ -1,25 +1,34 @@
 #pragma once
 
-#include "World.hpp"
+#include "WorldSnapshot.hpp"
 
 #include <SFML/Graphics.hpp>
 
+#include <map>
+#include <string>
+
 class UI
 {
 public:
-    UI( sf::RenderWindow& window, World& world );
-    void draw();
+    UI( sf::RenderWindow& window );
+    void draw( const WorldSnapshot& world );
+
+    /**
+     * Sets a line of text drawn in the top left corner, e.g. the simulation speed.
+     */
+    void setStatus( const std::string& status );
 
 protected:
     const sf::Texture& makeTexture( const std::string& part, sf::Color color );
 
 private:
     sf::RenderWindow& m_window;
-    World& m_world;
 
     std::map<std::string, sf::Texture> m_textures;
 
     sf::Texture m_groundTexture;
     sf::Font m_font;
     std::map<std::size_t, sf::Texture> m_explosionTextures;
+
+    std::string m_status;
 };
\ No newline at end of file
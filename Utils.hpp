@@ -2,8 +2,6 @@
 
 #include <algorithm>
 #include <cmath>
-#include <random>
-#include <chrono>
 
 /**
  * Utility class that provide methods for normalizing angles.
@@ -26,8 +24,6 @@ public:
     static constexpr double toRadians = M_PI / 180.;
     static constexpr double toDegrees = 180. / M_PI;
 
-    typedef std::default_random_engine RandomGenerator_t;
-
 	/**
 	 * Normalizes an angle to an absolute angle.
 	 * The normalized angle will be in the range from 0 to 2*PI, where 2*PI
@@ -178,18 +174,6 @@ public:
 		return (std::abs(value1 - value2) < NEAR_DELTA);
 	}
 
-	/**
-	 * Returns random number generator. It might be configured for repeatable behavior by setting -DRANDOMSEED option.
-	 *
-	 * @return random number generator
-	 */
-	static RandomGenerator_t& getRandom()
-    {
-		static unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-        static std::default_random_engine generator(seed);
-		return generator;
-	}
-
     static double signum( double value )
     {
         return std::copysign( 1., value );
@@ -1,39 +1,81 @@
 #include "World.hpp"
 
-World::World()
-: m_turn( 0 )
+#include <algorithm>
+#include <iterator>
+
+World::World( unsigned int width /*= 800*/, unsigned int height /*= 600*/,
+              std::size_t bulletCapacity /*= DEFAULT_BULLET_CAPACITY*/ )
+: m_width( width ),
+m_height( height ),
+m_turn( 0 ),
+m_lastBoxStamp( 0 ),
+m_bullets( bulletCapacity, width, height )
 {
 }
 
 void World::addRobot( Robot* pRobot )
 {
+    pRobot->setWorldIndex( m_robots.size() );
     m_robots.push_back( pRobot );
+    m_robotPairs.invalidate();
 }
 
-std::list<Robot*> World::getRobots()
+BulletHandle World::addBullet( Robot* owner, double power, double heading, double x, double y )
 {
-    return m_robots;
+    return m_bullets.add( owner, power, heading, x, y );
 }
 
-std::list<Bullet> World::getBullets()
+Span<const std::uint32_t> World::findScanTargets( const Arc2D& arc )
 {
-    return m_bullets;
+    // the grid is built with the robot pairs, from the same positions
+    if( m_robots.size() >= MIN_ROBOTS_FOR_SCAN_INDEX && !m_robotPairs.isStale() && m_robotGrid.isBuilt() )
+    {
+        return m_robotGrid.query( arc, m_robotPairs.getMargin() );
+    }
+
+    while( m_allRobots.size() < m_robots.size() )
+    {
+        m_allRobots.push_back( m_allRobots.size() );
+    }
+    return Span<const std::uint32_t>( m_allRobots.data(), m_robots.size() );
 }
 
-void World::addBullet( const Bullet& bullet )
+void World::recycleEvents()
 {
-    m_bullets.push_back( bullet );
+    for( Robot* pRobot : m_robots )
+    {
+        pRobot->retainEvents();
+    }
+    for( Robot* pRobot : m_deadRobots )
+    {
+        pRobot->retainEvents();
+    }
+    m_eventArena.flip();
 }
 
 void World::tick()
 {
+    Profiler& profiler = m_context.getProfiler();
+    Profiler::ScopedTimer tickTimer( profiler, Profiler::TICK );
+
     ++m_turn;
 
-    for( auto&& bullet : m_bullets )
+    // the robots received the events of the tick before the last one
+    recycleEvents();
+
     {
-        bullet.update( m_robots, m_bullets );
+        Profiler::ScopedTimer timer( profiler, Profiler::BULLET_UPDATE );
+        m_bullets.move();
+        // robots do not move while the bullets are updated
+        m_robotGrid.build( m_robots, m_width, m_height );
+        for( auto&& bullet : m_bullets )
+        {
+            bullet.update( m_robots, m_robotGrid, m_bullets );
+        }
     }
 
+    // a robot moves at most MAX_VELOCITY per turn, the others staying out of its reach until then
+    m_robotPairs.build( m_robots, Rules::MAX_VELOCITY );
     for( auto&& pRobot : m_robots )
     {
         pRobot->tick();
@@ -42,25 +84,80 @@ void World::tick()
     clearInactiveBullets();
 }
 
+void World::takeSnapshot( WorldSnapshot& snapshot )
+{
+    snapshot.width = getWidth();
+    snapshot.height = getHeight();
+    snapshot.turn = m_turn;
+
+    snapshot.robots.clear();
+    for( auto&& pRobot : m_robots )
+    {
+        Robot& robot = *pRobot;
+        Arc2D scanArc = robot.getScanArc();
+
+        WorldSnapshot::RobotState state;
+        state.name = &robot.getName();
+        state.x = robot.getX();
+        state.y = robot.getY();
+        state.bodyAngle = robot.getAngle();
+        state.turretAngle = robot.getTurretAngle();
+        state.radarAngle = robot.getRadarAngle();
+        state.energy = robot.getEnergy();
+        state.bodyColor = robot.getBodyColor();
+        state.gunColor = robot.getGunColor();
+        state.radarColor = robot.getRadarColor();
+        state.scanX[0] = scanArc.origin().x();
+        state.scanY[0] = scanArc.origin().y();
+        state.scanX[1] = scanArc.start().x();
+        state.scanY[1] = scanArc.start().y();
+        state.scanX[2] = scanArc.end().x();
+        state.scanY[2] = scanArc.end().y();
+
+        snapshot.robots.push_back( state );
+    }
+
+    snapshot.bullets.clear();
+    for( auto&& bullet : m_bullets )
+    {
+        WorldSnapshot::BulletState state;
+        state.x = bullet.getX();
+        state.y = bullet.getY();
+        state.power = bullet.getPower();
+        state.frame = bullet.getFrame();
+        state.state = bullet.getState();
+        state.color = bullet.getColor();
+
+        snapshot.bullets.push_back( state );
+    }
+}
+
 void World::clearDeadRobots()
 {
+    std::copy_if( m_robots.begin(), m_robots.end(), std::back_inserter( m_deadRobots ),
+        [](const Robot* r) { return r->isDead(); } );
     m_robots.erase(
         std::remove_if(m_robots.begin(), m_robots.end(),
             [](const Robot* r) { return r->isDead(); }),
         m_robots.end());
+
+    for( std::size_t i = 0; i < m_robots.size(); ++i )
+    {
+        m_robots[i]->setWorldIndex( i );
+    }
+    m_robotPairs.invalidate();
 }
 
 void World::clearInactiveBullets()
 {
-    m_bullets.erase(
-        std::remove_if(m_bullets.begin(), m_bullets.end(),
-            [](const Bullet& b) { return b.getState() == Bullet::INACTIVE; }),
-        m_bullets.end());
+    m_bullets.removeInactive();
 }
 
 void World::reset()
 {
     m_turn = 0;
     m_robots.clear();
+    m_deadRobots.clear();
+    m_robotPairs.invalidate();
     m_bullets.clear();
 }
\ No newline at end of file
@@ -2,33 +2,118 @@
 
 #include "Robot.hpp"
 #include "Bullet.hpp"
+#include "EventArena.hpp"
+#include "BulletPool.hpp"
+#include "RobotGrid.hpp"
+#include "SimulationContext.hpp"
+#include "SweepAndPrune.hpp"
+#include "Span.hpp"
+#include "WorldSnapshot.hpp"
 
-#include <list>
+#include <vector>
 
 class World
 {
 public:
-    World();
+    /** Default number of bullets that can be on the battlefield at the same time. */
+    static constexpr std::size_t DEFAULT_BULLET_CAPACITY = 4096;
+
+    /** Below this number of robots, testing them all is faster than looking up the ones near a radar arc. */
+    static constexpr std::size_t MIN_ROBOTS_FOR_SCAN_INDEX = 96;
+
+    World( unsigned int width = 800, unsigned int height = 600, std::size_t bulletCapacity = DEFAULT_BULLET_CAPACITY );
 
     void addRobot( Robot* pRobot );
 
-    std::list<Robot*> getRobots();
-    std::list<Bullet> getBullets();
+    /**
+     * Returns the robots in the world. The view is invalidated when a robot
+     * is added or removed.
+     */
+    Span<Robot*> getRobots() { return m_robots; }
+
+    BulletPool& getBullets() { return m_bullets; }
+
+    /** Broadphase of the robot-robot collisions, built at the start of the robots' turn. */
+    SweepAndPrune& getRobotPairs() { return m_robotPairs; }
 
-    unsigned int getWidth() { return 800; }
-    unsigned int getHeight() { return 600; }
+    /**
+     * Returns the indices of the robots that a radar arc may reach, in
+     * increasing order: those near the arc in large worlds whose robots did
+     * not move too much since the start of their turn, all of them otherwise.
+     *
+     * The span is valid until the next query.
+     */
+    Span<const std::uint32_t> findScanTargets( const Arc2D& arc );
+
+    unsigned int getWidth() { return m_width; }
+    unsigned int getHeight() { return m_height; }
     std::size_t getTurn() { return m_turn; }
 
-    void addBullet( const Bullet& bullet );
+    SimulationContext& getContext() { return m_context; }
+
+    /** Storage of the events of the robots of this world. */
+    EventArena& getEventArena() { return m_eventArena; }
+
+    /**
+     * Starts a new generation of events, recycling those of the tick before
+     * the last one; done at the start of every tick. The events the robots
+     * that left the world could not receive yet are kept.
+     */
+    void recycleEvents();
+
+    /**
+     * Adds a bullet to the world.
+     *
+     * @param owner the robot firing it
+     * @param power its power
+     * @param heading its heading, in degrees
+     * @param x its initial position
+     * @param y its initial position
+     * @return the handle of the bullet, or a null handle if there is no room left for it
+     */
+    BulletHandle addBullet( Robot* owner, double power, double heading, double x, double y );
+
+    /**
+     * Returns a new stamp for a robot whose bounding box changed: the stamps
+     * increase, so that a box stamped after a given stamp changed since.
+     */
+    std::uint64_t nextBoxStamp() { return ++m_lastBoxStamp; }
+
+    /**
+     * Returns the stamp of the last bounding box change.
+     */
+    std::uint64_t getBoxStamp() const { return m_lastBoxStamp; }
 
     void tick();
 
+    /**
+     * Copies what is needed to draw the world into the given snapshot,
+     * reusing its storage.
+     */
+    void takeSnapshot( WorldSnapshot& snapshot );
+
     void clearDeadRobots();
     void clearInactiveBullets();
     void reset();
 
 private:
+    SimulationContext m_context;
+    EventArena m_eventArena;
+    unsigned int m_width;
+    unsigned int m_height;
     std::size_t m_turn;
-    std::list<Robot*> m_robots;
-    std::list<Bullet> m_bullets;
+    std::uint64_t m_lastBoxStamp;
+    std::vector<Robot*> m_robots;
+
+    /** The robots removed by clearDeadRobots() this round, which can still get events. */
+    std::vector<Robot*> m_deadRobots;
+    BulletPool m_bullets;
+
+    /** Broadphase of the bullet-robot collisions, rebuilt every tick. */
+    RobotGrid m_robotGrid;
+
+    SweepAndPrune m_robotPairs;
+
+    /** 0 to the number of robots - 1. */
+    std::vector<std::uint32_t> m_allRobots;
 };
\ No newline at end of file
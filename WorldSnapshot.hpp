@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Bullet.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+
+#include <string>
+#include <vector>
+
+/**
+ * Immutable copy of what is needed to draw a World at a given turn, so that
+ * it can be rendered while the simulation goes on.
+ */
+struct WorldSnapshot
+{
+    struct RobotState
+    {
+        // the robot's name, which never changes and outlives the snapshot
+        const std::string* name;
+
+        float x;
+        float y;
+        float bodyAngle;
+        float turretAngle;
+        float radarAngle;
+        double energy;
+
+        sf::Color bodyColor;
+        sf::Color gunColor;
+        sf::Color radarColor;
+
+        // scan arc: origin, start and end points
+        float scanX[3];
+        float scanY[3];
+    };
+
+    struct BulletState
+    {
+        float x;
+        float y;
+        float power;
+        int frame;
+        Bullet::BulletState state;
+        sf::Color color;
+    };
+
+    unsigned int width = 0;
+    unsigned int height = 0;
+    std::size_t turn = 0;
+
+    std::vector<RobotState> robots;
+    std::vector<BulletState> bullets;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../Robot.hpp"
+#include "../World.hpp"
+
+/**
+ * Robot with a fixed, busy behaviour for the benchmarks: it keeps moving,
+ * turning, sweeping its radar and firing, and never dies.
+ */
+class BenchRobot : public Robot
+{
+public:
+    BenchRobot( World& world, int x, unsigned y, std::size_t index )
+    : Robot( world, "BenchRobot", x, y ),
+    m_index( index )
+    {
+    }
+
+    void run()
+    {
+        // keep the population constant whatever happens
+        setEnergy( 100, false );
+
+        setTurnBody( ( m_index % 2 ) ? 10 : -10 );
+        setTurnGun( 20 );
+        setTurnRadar( 45 );
+        setAhead( ( getWorld().getTurn() / 32 + m_index ) % 2 ? 100 : -100 );
+
+        if( ( getWorld().getTurn() + m_index ) % 16 == 0 )
+            setFire( 1 + m_index % 3 );
+    }
+
+    /**
+     * Sweeps the radar from the given heading to the current one.
+     */
+    void benchScan( double lastRadarHeading )
+    {
+        scan( lastRadarHeading, getWorld().getRobots() );
+    }
+
+private:
+    std::size_t m_index;
+};
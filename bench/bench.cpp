@@ -0,0 +1,649 @@
+#include "BenchRobot.hpp"
+
+#include "../World.hpp"
+#include "../Bullet.hpp"
+#include "../Arc2D.hpp"
+#include "../RandomStream.hpp"
+#include "../SinCos.hpp"
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+/*
+ * Every allocation of the process goes through here, so that the benchmarks
+ * can report how many allocations an operation performs.
+ */
+namespace
+{
+    std::size_t g_allocations = 0;
+}
+
+void* operator new( std::size_t size )
+{
+    ++g_allocations;
+    if( void* p = std::malloc( size ? size : 1 ) )
+        return p;
+    throw std::bad_alloc();
+}
+
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete( void* p ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void* p, std::size_t ) noexcept
+{
+    std::free( p );
+}
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const std::uint64_t SEED = 0x5EED;
+
+    struct Result
+    {
+        std::string name;
+        double nsPerOp;
+        double allocationsPerOp;
+    };
+
+    /**
+     * Measures one operation: `setup` runs untimed before each iteration and
+     * `op` is timed; `op` returns how many operations it performed.
+     */
+    Result measure( const std::string& name, std::function<void()> setup, std::function<std::size_t()> op,
+                    double minSeconds )
+    {
+        // warm up, so that the steady state is measured
+        for( int i = 0; i < 3; ++i )
+        {
+            setup();
+            op();
+        }
+
+        Clock::duration elapsed( 0 );
+        std::size_t ops = 0;
+        std::size_t allocations = 0;
+        std::size_t iterations = 0;
+
+        while( elapsed < std::chrono::duration<double>( minSeconds ) || iterations < 3 )
+        {
+            setup();
+
+            std::size_t allocationsBefore = g_allocations;
+            auto start = Clock::now();
+            ops += op();
+            elapsed += Clock::now() - start;
+            allocations += g_allocations - allocationsBefore;
+
+            ++iterations;
+        }
+
+        ops = std::max<std::size_t>( ops, 1 );
+        return Result{ name, std::chrono::duration<double, std::nano>( elapsed ).count() / ops, double( allocations ) / ops };
+    }
+
+    /**
+     * A world with a given number of robots and a fixed layout. The field
+     * grows with the robot count, so that the density stays the same as
+     * with 6 robots on the default 800x600 field.
+     */
+    struct BenchWorld
+    {
+        BenchWorld( std::size_t numRobots )
+        : world( std::max( 800., 800 * std::sqrt( numRobots / 6. ) ), std::max( 600., 600 * std::sqrt( numRobots / 6. ) ),
+                 std::max( World::DEFAULT_BULLET_CAPACITY, numRobots * 16 ) )
+        {
+            RandomStream random( SEED, numRobots );
+
+            for( std::size_t i = 0; i < numRobots; ++i )
+            {
+                int x = random.nextInt( Robot::WIDTH, world.getWidth() - Robot::WIDTH );
+                int y = random.nextInt( Robot::HEIGHT, world.getHeight() - Robot::HEIGHT );
+                robots.push_back( std::make_unique<BenchRobot>( world, x, y, i ) );
+                world.addRobot( robots.back().get() );
+            }
+
+            for( auto&& pRobot : robots )
+            {
+                pRobot->reset();
+            }
+        }
+
+        /**
+         * Adds bullets at random positions until there are numBullets of them.
+         */
+        void fillBullets( std::size_t numBullets, RandomStream& random )
+        {
+            for( std::size_t i = world.getBullets().size(); i < numBullets; ++i )
+            {
+                Robot* owner = robots[random.nextInt( 0, robots.size() - 1 )].get();
+                double power = 1 + random.nextInt( 0, 2 );
+                double heading = random.nextInt( 0, 359 );
+                double x = random.nextInt( 10, world.getWidth() - 10 );
+                double y = random.nextInt( 10, world.getHeight() - 10 );
+                world.addBullet( owner, power, heading, x, y );
+            }
+        }
+
+        World world;
+        std::vector<std::unique_ptr<BenchRobot>> robots;
+    };
+
+    void benchWorldTick( std::vector<Result>& results, std::size_t numRobots, std::size_t numBullets, double minSeconds )
+    {
+        BenchWorld bench( numRobots );
+        RandomStream random( SEED, numRobots * 7919 + numBullets );
+
+        results.push_back( measure(
+            "World::tick/robots=" + std::to_string( numRobots ) + "/bullets=" + std::to_string( numBullets ),
+            [&] { bench.fillBullets( numBullets, random ); },
+            [&] { bench.world.tick(); bench.world.clearDeadRobots(); return 1; },
+            minSeconds ) );
+    }
+
+    void benchBulletUpdate( std::vector<Result>& results, std::size_t numRobots, std::size_t numBullets, double minSeconds )
+    {
+        BenchWorld bench( numRobots );
+        RandomStream random( SEED, numRobots * 104729 + numBullets );
+
+        World& world = bench.world;
+        RobotGrid grid;
+
+        results.push_back( measure(
+            "Bullet::update/robots=" + std::to_string( numRobots ) + "/bullets=" + std::to_string( numBullets ),
+            [&] {
+                world.clearInactiveBullets();
+                bench.fillBullets( numBullets, random );
+            },
+            [&] {
+                world.getBullets().move();
+                grid.build( world.getRobots(), world.getWidth(), world.getHeight() );
+                for( auto&& bullet : world.getBullets() )
+                {
+                    bullet.update( world.getRobots(), grid, world.getBullets() );
+                }
+                return world.getBullets().size();
+            },
+            minSeconds ) );
+    }
+
+    void benchBulletMove( std::vector<Result>& results, std::size_t numBullets, double minSeconds )
+    {
+        BenchWorld bench( 8 );
+        RandomStream random( SEED, numBullets );
+
+        World& world = bench.world;
+
+        results.push_back( measure(
+            "BulletPool::move/bullets=" + std::to_string( numBullets ),
+            [&] {
+                world.clearInactiveBullets();
+                bench.fillBullets( numBullets, random );
+            },
+            [&] {
+                world.getBullets().move();
+                return world.getBullets().size();
+            },
+            minSeconds ) );
+    }
+
+    void benchPerformMove( std::vector<Result>& results, std::size_t numRobots, double minSeconds )
+    {
+        BenchWorld bench( numRobots );
+
+        results.push_back( measure(
+            "Robot::performMove/robots=" + std::to_string( numRobots ),
+            [&] {
+                // the robots get the events of their moves, as during a tick
+                bench.world.recycleEvents();
+                for( auto&& pRobot : bench.robots )
+                {
+                    pRobot->processEvents();
+                    pRobot->run();
+                }
+            },
+            [&] {
+                for( auto&& pRobot : bench.robots )
+                {
+                    pRobot->performMove();
+                }
+                return bench.robots.size();
+            },
+            minSeconds ) );
+    }
+
+    void benchScan( std::vector<Result>& results, std::size_t numRobots, double minSeconds )
+    {
+        BenchWorld bench( numRobots );
+        std::size_t turn = 0;
+
+        // builds the index of the robots, as at the start of a turn
+        bench.world.tick();
+
+        results.push_back( measure(
+            "Robot::scan/robots=" + std::to_string( numRobots ),
+            [&] {
+                ++turn;
+                bench.world.recycleEvents();
+            },
+            [&] {
+                // a 45 degree sweep, rotating from one turn to the next
+                for( auto&& pRobot : bench.robots )
+                {
+                    pRobot->benchScan( Utils::normalAbsoluteAngle( ( turn % 8 ) * Utils::PI / 4 ) );
+                    pRobot->processEvents();
+                }
+                return bench.robots.size();
+            },
+            minSeconds ) );
+    }
+
+    void benchArcIntersects( std::vector<Result>& results, double minSeconds )
+    {
+        RandomStream random( SEED );
+
+        std::vector<Arc2D> arcs;
+        std::vector<sf::FloatRect> rects;
+        for( int i = 0; i < 1024; ++i )
+        {
+            arcs.emplace_back( random.nextInt( 0, 800 ), random.nextInt( 0, 600 ), Rules::RADAR_SCAN_RADIUS,
+                               random.nextDouble() * Utils::TWO_PI, ( random.nextDouble() - .5 ) * Utils::PI / 2 );
+            rects.emplace_back( random.nextInt( 0, 800 ), random.nextInt( 0, 600 ), Robot::WIDTH, Robot::HEIGHT );
+        }
+
+        std::size_t hits = 0;
+        results.push_back( measure(
+            "Arc2D::intersects",
+            [] {},
+            [&] {
+                for( std::size_t i = 0; i < arcs.size(); ++i )
+                {
+                    hits += arcs[i].intersects( rects[( i * 7 ) % rects.size()] );
+                }
+                return arcs.size();
+            },
+            minSeconds ) );
+    }
+
+    void benchSinCos( std::vector<Result>& results, double minSeconds )
+    {
+        RandomStream random( SEED );
+
+        std::vector<double> angles;
+        for( int i = 0; i < 1024; ++i )
+        {
+            angles.push_back( random.nextDouble() * Utils::TWO_PI );
+        }
+
+        std::vector<double> x( angles.size() );
+        std::vector<double> y( angles.size() );
+        results.push_back( measure(
+            "SinCos",
+            [] {},
+            [&] {
+                for( std::size_t i = 0; i < angles.size(); ++i )
+                {
+                    SinCos heading( angles[i] );
+                    x[i] += heading.sin();
+                    y[i] += heading.cos();
+                }
+                return angles.size();
+            },
+            minSeconds ) );
+    }
+
+    /**
+     * Returns how far a value is from the exact one, in ulps of the exact one rounded.
+     */
+    double ulpError( double value, long double exact )
+    {
+        double rounded = std::abs( double( exact ) );
+        double ulp = rounded == 0 ? std::numeric_limits<double>::denorm_min()
+                                  : std::nextafter( rounded, std::numeric_limits<double>::infinity() ) - rounded;
+        return double( std::abs( value - exact ) / ulp );
+    }
+
+    /**
+     * Compares SinCos with the long double sine and cosine, on random angles
+     * and on multiples of PI/2, where the reduction is the hardest.
+     *
+     * @return the number of results more than 1 ulp away
+     */
+    std::size_t verifySinCos( std::size_t count )
+    {
+        RandomStream random( SEED );
+
+        double maxError = 0;
+        std::size_t failures = 0;
+        for( std::size_t i = 0; i < count; ++i )
+        {
+            // mostly headings, some as large as the bound allows
+            double range = i % 4 == 0 ? SinCos::MAX_ANGLE : Utils::TWO_PI;
+            double angle = ( random.nextDouble() * 2 - 1 ) * range;
+            if( i % 64 == 0 )
+            {
+                angle = std::nearbyint( angle / Utils::PI_OVER_TWO ) * Utils::PI_OVER_TWO;
+            }
+
+            SinCos sinCos( angle );
+            double error = std::max( ulpError( sinCos.sin(), std::sin( (long double) angle ) ),
+                                     ulpError( sinCos.cos(), std::cos( (long double) angle ) ) );
+            maxError = std::max( maxError, error );
+            if( error > 1 && ++failures <= 10 )
+            {
+                std::cerr << std::setprecision( 17 ) << "error: " << angle << ": " << error << " ulp" << std::endl;
+            }
+        }
+
+        std::cout << count << " angles, max error " << std::setprecision( 3 ) << maxError << " ulp, "
+                  << failures << " over 1 ulp" << std::endl;
+        return failures;
+    }
+
+    /**
+     * The arc test as it was first written, with boost::geometry polygons:
+     * the reference Arc2D must agree with.
+     */
+    bool referenceArcIntersects( double x, double y, double radius, double startAngle, double extent,
+                                 sf::FloatRect rect, Arc2D::Point& start, Arc2D::Point& end )
+    {
+        namespace bg = boost::geometry;
+        namespace trans = boost::geometry::strategy::transform;
+        typedef bg::model::d2::point_xy<double> Point;
+        typedef bg::model::polygon<Point> Polygon;
+
+        trans::rotate_transformer<bg::radian, double, 2, 2> rotate( startAngle );
+        trans::rotate_transformer<bg::radian, double, 2, 2> extend( startAngle + extent );
+        trans::translate_transformer<double, 2, 2> translate( x, y );
+
+        Point origin( x, y );
+        Point radiusPoint( 0, radius );
+        Point s, e;
+        bg::transform( radiusPoint, s, rotate );
+        bg::transform( s, s, translate );
+        bg::transform( radiusPoint, e, extend );
+        bg::transform( e, e, translate );
+        start = Arc2D::Point( s.x(), s.y() );
+        end = Arc2D::Point( e.x(), e.y() );
+
+        Polygon arc;
+        bg::append( arc, origin );
+        bg::append( arc, s );
+        bg::append( arc, e );
+        bg::append( arc, origin );
+        bg::correct( arc );
+
+        Polygon box;
+        bg::append( box, Point( rect.left, rect.top ) );
+        bg::append( box, Point( rect.left + rect.width, rect.top ) );
+        bg::append( box, Point( rect.left + rect.width, rect.top + rect.height ) );
+        bg::append( box, Point( rect.left, rect.top + rect.height ) );
+        bg::append( box, Point( rect.left, rect.top ) );
+        bg::correct( box );
+
+        return bg::intersects( arc, box );
+    }
+
+    /**
+     * Compares Arc2D with the reference test on random arcs and boxes
+     * around them.
+     *
+     * @return the number of disagreements
+     */
+    std::size_t verifyArc( std::size_t count )
+    {
+        RandomStream random( SEED );
+
+        std::size_t hits = 0;
+        std::size_t mismatches = 0;
+        for( std::size_t i = 0; i < count; ++i )
+        {
+            double x = random.nextDouble() * 800;
+            double y = random.nextDouble() * 600;
+            double startAngle = random.nextDouble() * Utils::TWO_PI;
+            // some scans do not turn at all
+            double extent = i % 16 == 0 ? 0 : ( random.nextDouble() - .5 ) * Utils::PI;
+            double radius = Rules::RADAR_SCAN_RADIUS;
+
+            // boxes within reach, most of them near the border of the arc
+            double distance = random.nextDouble() * ( radius + Robot::WIDTH );
+            double angle = startAngle + ( random.nextDouble() * 1.5 - .25 ) * extent + ( random.nextDouble() - .5 ) * .2;
+            sf::FloatRect rect( float( x + distance * std::sin( angle ) - Robot::WIDTH / 2 ),
+                                float( y + distance * std::cos( angle ) - Robot::HEIGHT / 2 ),
+                                float( Robot::WIDTH ), float( Robot::HEIGHT ) );
+
+            Arc2D arc( x, y, radius, startAngle, extent );
+            Arc2D::Point start, end;
+            bool expected = referenceArcIntersects( x, y, radius, startAngle, extent, rect, start, end );
+            bool actual = arc.intersects( rect );
+
+            hits += expected;
+            // the corners may differ in the last bits, depending on how the compiler fuses the operations
+            const double tolerance = 1e-9;
+            if( actual != expected
+                    || std::abs( start.x() - arc.start().x() ) > tolerance || std::abs( start.y() - arc.start().y() ) > tolerance
+                    || std::abs( end.x() - arc.end().x() ) > tolerance || std::abs( end.y() - arc.end().y() ) > tolerance )
+            {
+                if( ++mismatches <= 10 )
+                {
+                    std::cerr << std::setprecision( 17 ) << "mismatch: arc " << x << " " << y << " " << startAngle << " " << extent
+                              << " box " << rect.left << " " << rect.top << ": expected " << expected << ", got " << actual << std::endl;
+                }
+            }
+        }
+
+        std::cout << count << " arcs, " << hits << " hits, " << mismatches << " mismatches" << std::endl;
+        return mismatches;
+    }
+
+    void print( const std::vector<Result>& results, const boost::property_tree::ptree* pBaseline )
+    {
+        std::cout << std::left << std::setw( 48 ) << "benchmark"
+                  << std::right << std::setw( 14 ) << "ns/op"
+                  << std::setw( 14 ) << "ops/s"
+                  << std::setw( 12 ) << "allocs/op";
+        if( pBaseline )
+            std::cout << std::setw( 14 ) << "baseline" << std::setw( 10 ) << "change";
+        std::cout << std::endl;
+
+        for( auto&& r : results )
+        {
+            std::cout << std::left << std::setw( 48 ) << r.name
+                      << std::right << std::fixed << std::setprecision( 1 )
+                      << std::setw( 14 ) << r.nsPerOp
+                      << std::setw( 14 ) << std::setprecision( 0 ) << 1e9 / r.nsPerOp
+                      << std::setw( 12 ) << std::setprecision( 2 ) << r.allocationsPerOp;
+
+            if( pBaseline )
+            {
+                // keys contain '/', so '|' is used as the path separator
+                auto baseline = pBaseline->get_optional<double>( boost::property_tree::ptree::path_type( r.name + "|ns_per_op", '|' ) );
+                if( baseline )
+                {
+                    std::cout << std::setw( 14 ) << std::setprecision( 1 ) << *baseline
+                              << std::setw( 9 ) << std::showpos << std::setprecision( 1 )
+                              << ( r.nsPerOp / *baseline - 1 ) * 100 << "%" << std::noshowpos;
+                }
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    /**
+     * Runs a melee past its warm-up, and counts the allocations made for
+     * the events of the following ticks.
+     *
+     * @return the number of allocations
+     */
+    std::size_t verifyEvents( std::size_t numTicks )
+    {
+        BenchWorld bench( 128 );
+        EventArena& events = bench.world.getEventArena();
+
+        for( int i = 0; i < 64; ++i )
+        {
+            bench.world.tick();
+        }
+
+        std::uint64_t eventsBefore = events.getEventCount();
+        std::uint64_t eventAllocationsBefore = events.getAllocationCount();
+        std::size_t allocationsBefore = g_allocations;
+        for( std::size_t i = 0; i < numTicks; ++i )
+        {
+            bench.world.tick();
+        }
+        std::uint64_t eventAllocations = events.getAllocationCount() - eventAllocationsBefore;
+
+        std::cout << numTicks << " ticks, " << events.getEventCount() - eventsBefore << " events, "
+                  << eventAllocations << " event allocations (" << g_allocations - allocationsBefore << " in total)" << std::endl;
+        return eventAllocations;
+    }
+
+    void save( const std::vector<Result>& results, const std::string& file )
+    {
+        boost::property_tree::ptree tree;
+        for( auto&& r : results )
+        {
+            boost::property_tree::ptree entry;
+            entry.put( "ns_per_op", r.nsPerOp );
+            entry.put( "allocs_per_op", r.allocationsPerOp );
+            tree.push_back( std::make_pair( r.name, entry ) );
+        }
+        boost::property_tree::write_json( file, tree );
+    }
+}
+
+/**
+ * Engine microbenchmarks. Workloads are generated from fixed seeds, so that
+ * two runs measure exactly the same thing.
+ *
+ * usage: robocodepp-bench [--quick] [--baseline file.json] [--save file.json] [--filter text]
+ *        robocodepp-bench --verify-arc [count]
+ *        robocodepp-bench --verify-events [ticks]
+ *        robocodepp-bench --verify-sincos [count]
+ *
+ * --verify-arc compares Arc2D with a reference test on a random corpus
+ * instead, and fails if they disagree. --verify-events runs a melee and
+ * fails if its events allocate anything once warmed up. --verify-sincos
+ * checks the error bound of SinCos.
+ */
+int main( int argc, char* argv[] )
+{
+    double minSeconds = 0.5;
+    std::string baselineFile = "bench/baseline.json";
+    std::string saveFile;
+    std::string filter;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+        if( arg == "--quick" )
+            minSeconds = 0.05;
+        else if( arg == "--baseline" && i + 1 < argc )
+            baselineFile = argv[++i];
+        else if( arg == "--save" && i + 1 < argc )
+            saveFile = argv[++i];
+        else if( arg == "--filter" && i + 1 < argc )
+            filter = argv[++i];
+        else if( arg == "--verify-arc" )
+        {
+            std::size_t count = i + 1 < argc ? std::stoul( argv[++i] ) : 1000000;
+            return verifyArc( count ) == 0 ? 0 : 1;
+        }
+        else if( arg == "--verify-events" )
+        {
+            std::size_t numTicks = i + 1 < argc ? std::stoul( argv[++i] ) : 10000;
+            return verifyEvents( numTicks ) == 0 ? 0 : 1;
+        }
+        else if( arg == "--verify-sincos" )
+        {
+            std::size_t count = i + 1 < argc ? std::stoul( argv[++i] ) : 10000000;
+            return verifySinCos( count ) == 0 ? 0 : 1;
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--quick] [--baseline file.json] [--save file.json] [--filter text]" << std::endl;
+            std::cerr << "       " << argv[0] << " --verify-arc [count]" << std::endl;
+            std::cerr << "       " << argv[0] << " --verify-events [ticks]" << std::endl;
+            std::cerr << "       " << argv[0] << " --verify-sincos [count]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<Result> results;
+    auto selected = [&]( const std::string& name ) { return filter.empty() || name.find( filter ) != std::string::npos; };
+
+    const std::size_t robotCounts[] = { 2, 8, 32, 128, 512, 1024 };
+
+    for( std::size_t numRobots : robotCounts )
+    {
+        if( selected( "World::tick" ) )
+        {
+            benchWorldTick( results, numRobots, 0, minSeconds );
+            benchWorldTick( results, numRobots, numRobots * 4, minSeconds );
+        }
+    }
+    if( selected( "Bullet::update" ) )
+        benchBulletUpdate( results, 128, 1024, minSeconds );
+    for( std::size_t numBullets : { 16, 128, 1024 } )
+    {
+        if( selected( "Bullet::update" ) )
+            benchBulletUpdate( results, 8, numBullets, minSeconds );
+        if( selected( "BulletPool::move" ) )
+            benchBulletMove( results, numBullets, minSeconds );
+    }
+    for( std::size_t numRobots : robotCounts )
+    {
+        if( selected( "Robot::performMove" ) )
+            benchPerformMove( results, numRobots, minSeconds );
+        if( selected( "Robot::scan" ) )
+            benchScan( results, numRobots, minSeconds );
+    }
+    if( selected( "Arc2D::intersects" ) )
+        benchArcIntersects( results, minSeconds );
+    if( selected( "SinCos" ) )
+        benchSinCos( results, minSeconds );
+
+    boost::property_tree::ptree baseline;
+    bool haveBaseline = false;
+    try
+    {
+        boost::property_tree::read_json( baselineFile, baseline );
+        haveBaseline = true;
+    }
+    catch( const boost::property_tree::json_parser_error& )
+    {
+        std::cerr << "no baseline read from '" << baselineFile << "'" << std::endl;
+    }
+
+    print( results, haveBaseline ? &baseline : nullptr );
+
+    if( !saveFile.empty() )
+    {
+        save( results, saveFile );
+    }
+
+    return 0;
+}
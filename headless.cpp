@@ -0,0 +1,204 @@
+#include "BattleFarm.hpp"
+#include "Round.hpp"
+#include "RandomStream.hpp"
+
+#include "testBots/SpinRobot.hpp"
+#include "testBots/StaticRobot.hpp"
+#include "testBots/VelociRobot.hpp"
+#include "testBots/SuperTracker.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void printResults( std::vector<BattleResults> results )
+    {
+        std::cout << std::left
+                  << std::setw( 6 ) << "Rank"
+                  << std::setw( 16 ) << "Robot"
+                  << std::right
+                  << std::setw( 8 ) << "Score"
+                  << std::setw( 10 ) << "Survival"
+                  << std::setw( 10 ) << "Surv Bns"
+                  << std::setw( 8 ) << "Bullet"
+                  << std::setw( 8 ) << "Bul Bns"
+                  << std::setw( 8 ) << "Ram"
+                  << std::setw( 8 ) << "Ram Bns"
+                  << std::setw( 6 ) << "1sts"
+                  << std::setw( 6 ) << "2nds"
+                  << std::setw( 6 ) << "3rds"
+                  << std::endl;
+
+        for( auto&& r : results )
+        {
+            std::cout << std::left
+                      << std::setw( 6 ) << r.getRank()
+                      << std::setw( 16 ) << r.getTeamLeaderName()
+                      << std::right
+                      << std::setw( 8 ) << r.getScore()
+                      << std::setw( 10 ) << r.getSurvival()
+                      << std::setw( 10 ) << r.getLastSurvivorBonus()
+                      << std::setw( 8 ) << r.getBulletDamage()
+                      << std::setw( 8 ) << r.getBulletDamageBonus()
+                      << std::setw( 8 ) << r.getRamDamage()
+                      << std::setw( 8 ) << r.getRamDamageBonus()
+                      << std::setw( 6 ) << r.getFirsts()
+                      << std::setw( 6 ) << r.getSeconds()
+                      << std::setw( 6 ) << r.getThirds()
+                      << std::endl;
+        }
+    }
+
+    /**
+     * Runs a round-robin (or melee) tournament between the test bots, reusing
+     * the results cached in the given file for the pairings that did not change.
+     */
+    int runTournament( const std::string& cacheFile, std::size_t meleeSize, const std::vector<std::string>& rerun,
+                       std::size_t numRounds, std::size_t numThreads, std::uint64_t seed, bool profile )
+    {
+        // bump a version when the bot changes, or pass --rerun with its name
+        std::vector<Contestant> roster = {
+            { "SpinRobot", "1", []( World& world ) { return std::make_unique<SpinRobot>( world, 400, 340 ); } },
+            { "StaticRobot", "1", []( World& world ) { return std::make_unique<StaticRobot>( world, 400, 300, 360 * 1./30 ); } },
+            { "VelociRobot", "1", []( World& world ) { return std::make_unique<VelociRobot>( world ); } },
+            { "SuperTracker", "1", []( World& world ) { return std::make_unique<SuperTracker>( world ); } }
+        };
+
+        Round round( roster, numRounds, seed );
+        if( meleeSize > 0 )
+            round.scheduleMelee( meleeSize );
+        else
+            round.scheduleRoundRobin();
+
+        std::size_t cached = round.loadResults( cacheFile );
+        for( auto&& name : rerun )
+        {
+            round.invalidate( name );
+        }
+
+        BattleFarm farm( numThreads );
+        std::size_t run = round.run( farm, profile );
+        round.saveResults( cacheFile );
+
+        std::cout << std::endl;
+        printResults( round.getLeagueTable() );
+        std::cout << std::endl
+                  << round.getMatches().size() << " matches, " << run << " run, "
+                  << round.getMatches().size() - run << " from the " << cached << " cached in " << cacheFile
+                  << std::endl;
+
+        if( profile && run > 0 )
+        {
+            std::cout << std::endl;
+            farm.getProfile().report( std::cout );
+        }
+
+        return 0;
+    }
+}
+
+/**
+ * Runs battles without any window, UI or frame pacing: the battles are
+ * ticked as fast as the CPU allows, spread over a pool of worker threads,
+ * and the results are printed at the end.
+ *
+ * Battle i is seeded with the i-th stream of the given seed, so a run can be
+ * reproduced exactly by passing the seed it printed.
+ *
+ * With --profile, the time spent in each phase of the ticks is printed
+ * after the results.
+ *
+ * With --tournament, the test bots play every 1v1 pairing (or every melee
+ * group of the given size) instead, and the league table is printed. The
+ * results are cached in the given file, so that the next run only plays
+ * the matches of the bots passed with --rerun. The seed defaults to 0 so
+ * that the cached results stay valid.
+ *
+ * usage: robocodepp-headless [--profile] [numRounds] [numBattles] [numThreads] [seed]
+ *        robocodepp-headless [--profile] --tournament results.json [--melee groupSize] [--rerun name]...
+ *                            [numRounds] [numThreads] [seed]
+ */
+int main( int argc, char* argv[] )
+{
+    bool profile = false;
+    std::string tournament;
+    std::size_t meleeSize = 0;
+    std::vector<std::string> rerun;
+    std::vector<const char*> args;
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+        if( arg == "--profile" )
+            profile = true;
+        else if( arg == "--tournament" && i + 1 < argc )
+            tournament = argv[++i];
+        else if( arg == "--melee" && i + 1 < argc )
+            meleeSize = std::strtoul( argv[++i], nullptr, 10 );
+        else if( arg == "--rerun" && i + 1 < argc )
+            rerun.push_back( argv[++i] );
+        else
+            args.push_back( argv[i] );
+    }
+
+    if( !tournament.empty() )
+    {
+        return runTournament( tournament, meleeSize, rerun,
+                              args.size() > 0 ? std::strtoul( args[0], nullptr, 10 ) : 10,
+                              args.size() > 1 ? std::strtoul( args[1], nullptr, 10 ) : std::thread::hardware_concurrency(),
+                              args.size() > 2 ? std::strtoull( args[2], nullptr, 10 ) : 0,
+                              profile );
+    }
+
+    std::size_t numRounds = args.size() > 0 ? std::strtoul( args[0], nullptr, 10 ) : 10;
+    std::size_t numBattles = args.size() > 1 ? std::strtoul( args[1], nullptr, 10 ) : 1;
+    std::size_t numThreads = args.size() > 2 ? std::strtoul( args[2], nullptr, 10 ) : std::thread::hardware_concurrency();
+    std::uint64_t seed = args.size() > 3 ? std::strtoull( args[3], nullptr, 10 )
+                                         : std::chrono::system_clock::now().time_since_epoch().count();
+
+    std::cout << "SYSTEM: seed " << seed << std::endl;
+
+    BattleFarm::BattleSetup setup;
+    setup.numRounds = numRounds;
+    setup.profile = profile;
+    setup.robots = {
+        []( World& world ) { return std::make_unique<SpinRobot>( world, 400, 340 ); },
+        []( World& world ) { return std::make_unique<StaticRobot>( world, 200, 400, 360 * 1./30 ); },
+        []( World& world ) { return std::make_unique<StaticRobot>( world, 200, 200, 0, 0, 360 * 1./30 ); },
+        []( World& world ) { return std::make_unique<StaticRobot>( world, 400, 300, 360 * 1./30 ); },
+        []( World& world ) { return std::make_unique<VelociRobot>( world, 100, 100 ); },
+        []( World& world ) { return std::make_unique<SuperTracker>( world, 100, 200 ); }
+    };
+
+    BattleFarm farm( std::min( numThreads, numBattles ) );
+
+    auto start = std::chrono::steady_clock::now();
+
+    for( std::size_t i = 0; i < numBattles; ++i )
+    {
+        setup.seed = RandomStream::deriveSeed( seed, i );
+        farm.submit( setup );
+    }
+    auto results = farm.wait();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << std::endl;
+    printResults( numBattles == 1 ? results.front() : BattleFarm::aggregate( results ) );
+    std::cout << std::endl
+              << numBattles << " battles, " << farm.getTickCount() << " ticks in " << elapsed.count() << " s on "
+              << farm.getNumThreads() << " threads (" << (int) ( farm.getTickCount() / elapsed.count() ) << " ticks/s)"
+              << std::endl;
+
+    if( profile )
+    {
+        std::cout << std::endl;
+        farm.getProfile().report( std::cout );
+    }
+
+    return 0;
+}
@@ -2,22 +2,44 @@
 #include "UI.hpp"
 #include "World.hpp"
 #include "Battle.hpp"
+#include "SimulationThread.hpp"
+#include "TripleBuffer.hpp"
 
 #include "testBots/SpinRobot.hpp"
 #include "testBots/StaticRobot.hpp"
 #include "testBots/VelociRobot.hpp"
 #include "testBots/SuperTracker.hpp"
 
+#include "tools/makeString.hpp"
+
 #include <SFML/Graphics.hpp>
 
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <string>
+
+namespace
+{
+    std::string statusLabel( const SimulationThread& simulation )
+    {
+        std::string profiling = simulation.isProfiling() ? " - profiling" : "";
+        if( simulation.getSpeed() == SimulationThread::UNLIMITED )
+            return "speed: unlimited" + profiling;
+        return tools::makeString() << "speed: " << simulation.getSpeed() << "x" << profiling;
+    }
+}
 
+/**
+ * Keys 1, 2, 3 and 4 set the simulation speed to 1x, 2x, 8x and unlimited.
+ * Key P toggles the tick profiler, whose report goes to the console.
+ */
 int main()
 {
     sf::RenderWindow window(sf::VideoMode(800, 600), "Robocode++");
 
     World world;
-    UI ui( window, world );
+    UI ui( window );
 
     SpinRobot r1( world, 400, 340 );
     StaticRobot r2( world, 200, 200, 0, 0, 360 * 1./30 );
@@ -26,7 +48,10 @@ int main()
     VelociRobot r5( world, 100, 100 );
     SuperTracker r6( world, 100, 200 );
 
-    Battle battle( world, 10 );
+    std::uint64_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+    std::cout << "SYSTEM: battle seed " << seed << std::endl;
+
+    Battle battle( world, 10, seed );
 
     battle.addRobot( &r1 );
     battle.addRobot( &r3 );
@@ -35,24 +60,45 @@ int main()
     battle.addRobot( &r5 );
     battle.addRobot( &r6 );
 
+    TripleBuffer<WorldSnapshot> snapshots;
+    SimulationThread simulation( battle, world, snapshots, 30 );
+    simulation.start();
+    ui.setStatus( statusLabel( simulation ) );
+
     while (window.isOpen())
     {
-        sf::Clock clock;
-
         sf::Event event;
-        if( window.pollEvent(event) )
+        while( window.pollEvent(event) )
         {
             if (event.type == sf::Event::Closed)
                 window.close();
-        }
 
-        battle.tick();
+            if( event.type == sf::Event::KeyPressed )
+            {
+                switch( event.key.code )
+                {
+                case sf::Keyboard::Num1: simulation.setSpeed( 1 ); break;
+                case sf::Keyboard::Num2: simulation.setSpeed( 2 ); break;
+                case sf::Keyboard::Num3: simulation.setSpeed( 8 ); break;
+                case sf::Keyboard::Num4: simulation.setSpeed( SimulationThread::UNLIMITED ); break;
+                case sf::Keyboard::P: simulation.setProfiling( !simulation.isProfiling() ); break;
+                default: break;
+                }
+                ui.setStatus( statusLabel( simulation ) );
+            }
+        }
 
-        ui.draw();
-        
-        sf::sleep( sf::seconds(1./30) - clock.getElapsedTime() );
-        //sf::sleep( sf::seconds(1.) - clock.getElapsedTime() );
+        if( snapshots.update() )
+        {
+            ui.draw( snapshots.front() );
+        }
+        else
+        {
+            sf::sleep( sf::milliseconds(1) );
+        }
     }
 
+    simulation.stop();
+
     return 0;
 }
\ No newline at end of file
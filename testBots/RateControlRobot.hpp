@@ -47,7 +47,11 @@ class RateControlRobot : public Robot
 {
 public:
     RateControlRobot( World& world, const std::string& name, int x = 400, unsigned y = 300 )
-	: Robot( world, name, x, y )
+	: Robot( world, name, x, y ),
+	m_velocityRate( 0 ),
+	m_turnRate( 0 ),
+	m_gunRotationRate( 0 ),
+	m_radarRotationRate( 0 )
 	{}
 
 	/**
@@ -1,13 +1,12 @@
 #include "StaticRobot.hpp"
 
+#include "../World.hpp"
+
 void StaticRobot::run()
 {
-    static bool start = true;
-    
-    if( start )
+    if( getWorld().getTurn() == 1 )
     {
         rotate( 42 );
-        start = false;
     }
     setTurnBody( m_bodySpin );
     setTurnGun( m_gunSpin );
@@ -68,6 +68,12 @@ public:
 		setVelocityRate( -1 * getVelocityRate() );
 	}
 
+	void onRoundEnded( RoundEndedEvent* e )
+    {
+		// Start the next round from scratch
+		m_turnCounter = 0;
+	}
+
 private:
 	int m_turnCounter;
 };
\ No newline at end of file